@@ -0,0 +1,69 @@
+#ifndef ASSETLOADER_HPP
+#define ASSETLOADER_HPP
+
+#include "Constants.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Runs file decode jobs (images, sound buffers) on worker threads so the
+// main thread can keep drawing. Jobs are queued with add() and then
+// start() launches the workers. Anything that touches the GL context
+// (texture upload) must be done by the caller once a job's future is ready.
+class AssetLoader {
+public:
+  explicit AssetLoader(int threadCount = ASSET_LOADER_THREADS)
+      : threadCount(threadCount) {}
+
+  ~AssetLoader() {
+    for (auto &worker : workers)
+      worker.join();
+  }
+
+  AssetLoader(const AssetLoader &) = delete;
+  AssetLoader &operator=(const AssetLoader &) = delete;
+
+  // Must be called before start(); the future reports the job's result
+  std::future<bool> add(std::function<bool()> job) {
+    jobs.emplace_back(std::move(job));
+    return jobs.back().get_future();
+  }
+
+  void start() {
+    int count = threadCount;
+    if (count <= 0)
+      count = static_cast<int>(std::thread::hardware_concurrency());
+    count = std::max(1, std::min(count, static_cast<int>(jobs.size())));
+    for (int i = 0; i < count; i++)
+      workers.emplace_back([this] { workerLoop(); });
+  }
+
+  int total() const { return static_cast<int>(jobs.size()); }
+  int completed() const { return finished.load(); }
+  bool done() const { return completed() == total(); }
+
+  float progress() const {
+    return jobs.empty() ? 1.0f
+                        : static_cast<float>(completed()) / total();
+  }
+
+private:
+  int threadCount;
+  std::vector<std::packaged_task<bool()>> jobs;
+  std::vector<std::thread> workers;
+  std::atomic<int> next{0};
+  std::atomic<int> finished{0};
+
+  void workerLoop() {
+    for (int i = next++; i < total(); i = next++) {
+      jobs[i]();
+      finished++;
+    }
+  }
+};
+
+#endif
@@ -1,90 +1,44 @@
 #ifndef ASTRONAUT_HPP
 #define ASTRONAUT_HPP
 
+#include "Config.hpp"
 #include "Constants.h"
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
 #include <cmath>
-#include <cstdlib>
-#include <iostream>
-#include <memory>
-#include <vector>
 
+// Simulation state of the player's ship. Rendering lives in WorldRenderer so
+// this class can be stepped without a window.
 class Astronaut {
 public:
-  sf::Texture texHealthy, texDamaged, texBroken;
-  std::unique_ptr<sf::Sprite> body;
+  sf::Vector2f position{tuning.worldWidth * 0.1f,
+                        tuning.worldHeight * 0.1f};
 
-  float angle = static_cast<float>(rand() % 360);
-  float rotationSpeed = ROTATION_SPEED;
+  float angle = 0.f;
+  float rotationSpeed = tuning.rotationSpeed;
   sf::Vector2f velocity{0.f, 0.f};
-  float thrustPower = THRUST_POWER;
+  float thrustPower = tuning.thrustPower;
 
-  float oxygen = OXYGEN_MAX;
-  float oxygenDrainRate = OXYGEN_DRAIN_NORMAL;
-  float thrustCapacity = THRUST_CAPACITY_MAX;
-  float thrustDrainRate = THRUST_DRAIN_RATE;
+  float oxygen = tuning.oxygenMax;
+  float oxygenDrainRate = tuning.oxygenDrainNormal;
+  float collisionDrainFactor = tuning.oxygenDrainCollision; // Per unit of speed
+  float thrustCapacity = tuning.thrustCapacityMax;
+  float thrustDrainRate = tuning.thrustDrainRate;
   bool isDead = false;
 
   int currentShipState = 0; // 0=healthy, 1=damaged, 2=broken
   bool isCurrentlyThrusting = false;
-  float angularVelocity = static_cast<float>((rand() % 100) + 50);
-  float mass = ASTRO_MASS;
-  float inertia = ASTRO_INERTIA;
-
-  Astronaut() {
-    if (!texHealthy.loadFromFile(TEX_SHIP_HEALTHY)) {
-      std::cerr << "Warning: Could not load " << TEX_SHIP_HEALTHY << std::endl;
-    }
-    if (!texDamaged.loadFromFile(TEX_SHIP_DAMAGED)) {
-      std::cerr << "Warning: Could not load " << TEX_SHIP_DAMAGED << std::endl;
-    }
-    if (!texBroken.loadFromFile(TEX_SHIP_BROKEN)) {
-      std::cerr << "Warning: Could not load " << TEX_SHIP_BROKEN << std::endl;
-    }
-
-    body = std::make_unique<sf::Sprite>(texHealthy);
-
-    sf::Vector2u texSize = texHealthy.getSize();
-    float scale = (ASTRO_RADIUS * 2.0f) / static_cast<float>(texSize.x);
-    body->setScale({scale, scale});
-    body->setOrigin({texSize.x / 2.0f, texSize.y / 2.0f});
-    body->setPosition({ASTRO_START_POS_X, ASTRO_START_POS_Y});
-  }
-
-  void updateTexture() {
-    // Texture switching logic driven by oxygen levels
-    int newState;
-    if (oxygen > SHIP_HEALTHY_THRESHOLD) {
-      newState = 0;
-    } else if (oxygen > SHIP_DAMAGED_THRESHOLD) {
-      newState = 1;
+  float angularVelocity = 0.f; // Spin is chosen by World on (re)start
+  float mass = tuning.astroMass;
+  float inertia = tuning.astroInertia;
+
+  void updateShipState() {
+    // Hull damage state driven by oxygen levels
+    if (oxygen > tuning.shipHealthyThreshold) {
+      currentShipState = 0;
+    } else if (oxygen > tuning.shipDamagedThreshold) {
+      currentShipState = 1;
     } else {
-      newState = 2;
-    }
-
-    if (newState != currentShipState) {
-      currentShipState = newState;
-      sf::Vector2u texSize;
-
-      switch (currentShipState) {
-      case 0:
-        body->setTexture(texHealthy);
-        texSize = texHealthy.getSize();
-        break;
-      case 1:
-        body->setTexture(texDamaged);
-        texSize = texDamaged.getSize();
-        break;
-      case 2:
-        body->setTexture(texBroken);
-        texSize = texBroken.getSize();
-        break;
-      }
-
-      // Re-center origin for geometric consistency
-      body->setOrigin({texSize.x / 2.0f, texSize.y / 2.0f});
-      float scale = (ASTRO_RADIUS * 2.0f) / static_cast<float>(texSize.x);
-      body->setScale({scale, scale});
+      currentShipState = 2;
     }
   }
 
@@ -97,7 +51,7 @@ public:
     // Temporal oxygen depletion
     deplet_oxygen(dt * oxygenDrainRate);
 
-    updateTexture();
+    updateShipState();
 
     // Physics integration
     if (has_thrust()) {
@@ -108,13 +62,13 @@ public:
       if (angle < 0.f)
         angle += 360.f;
 
-      // Rotational damping
-      angularVelocity *= ANGULAR_DAMPING;
+      // Rotational damping, a per-second factor so it is step-size independent
+      angularVelocity *= std::pow(tuning.angularDamping, dt);
 
       // Ensure minimum angular velocity to prevent player stalling
-      if (std::abs(angularVelocity) < MIN_ANGULAR_VELOCITY) {
-        angularVelocity = (angularVelocity >= 0) ? MIN_ANGULAR_VELOCITY
-                                                 : -MIN_ANGULAR_VELOCITY;
+      if (std::abs(angularVelocity) < tuning.minAngularVelocity) {
+        angularVelocity = (angularVelocity >= 0) ? tuning.minAngularVelocity
+                                                 : -tuning.minAngularVelocity;
       }
 
       if (isThrusting) {
@@ -123,7 +77,8 @@ public:
 
         // Apply force scaled by engine integrity
         velocity += thrustDir *
-                    (thrustPower * (thrustCapacity / THRUST_CAPACITY_MAX)) * dt;
+                    (thrustPower * (thrustCapacity / tuning.thrustCapacityMax)) *
+                    dt;
 
         // Permanent engine wear
         deplet_thrust(thrustDrainRate * dt);
@@ -131,22 +86,21 @@ public:
     }
 
     // Integrate velocity to update position
-    body->move(velocity * dt);
+    position += velocity * dt;
 
-    // Periodic boundary conditions
-    sf::Vector2f pos = body->getPosition();
-    if (pos.x < 0)
-      pos.x = WINDOW_WIDTH;
-    if (pos.x > WINDOW_WIDTH)
-      pos.x = 0;
-    if (pos.y < 0)
-      pos.y = WINDOW_HEIGHT;
-    if (pos.y > WINDOW_HEIGHT)
-      pos.y = 0;
-    body->setPosition(pos);
+    wrapPosition();
+  }
 
-    // Align sprite orientation with thrust vector
-    body->setRotation(sf::degrees(angle + 180.0f));
+  // Periodic boundary conditions
+  void wrapPosition() {
+    if (position.x < 0)
+      position.x = tuning.worldWidth;
+    if (position.x > tuning.worldWidth)
+      position.x = 0;
+    if (position.y < 0)
+      position.y = tuning.worldHeight;
+    if (position.y > tuning.worldHeight)
+      position.y = 0;
   }
 
   void kill_thruster() {
@@ -169,132 +123,17 @@ public:
       kill_thruster();
   }
 
-  bool has_thrust() { return thrustCapacity > 0; }
+  bool has_thrust() const { return thrustCapacity > 0; }
 
   // Physics interface
-  float getRadius() const { return ASTRO_RADIUS; }
-  sf::Vector2f getPosition() const { return body->getPosition(); }
-
-  void reset() {
-    // Reset position
-    body->setPosition({ASTRO_START_POS_X, ASTRO_START_POS_Y});
-
-    // Reset physics
-    angle = 0.0f;
-    angularVelocity = static_cast<float>((rand() % 100) + 50);
-    rotationSpeed = ROTATION_SPEED;
-    velocity = {0.f, 0.f};
-    thrustPower = THRUST_POWER;
-
-    // Reset survival stats
-    oxygen = OXYGEN_MAX;
-    oxygenDrainRate = OXYGEN_DRAIN_NORMAL;
-    thrustCapacity = THRUST_CAPACITY_MAX;
-    thrustDrainRate = THRUST_DRAIN_RATE;
-    isDead = false;
-
-    // Reset textures
-    currentShipState = 0;
-    body->setTexture(texHealthy);
-    body->setRotation(sf::degrees(0.f));
-  }
-
-  // Render procedural engine exhaust
-  void drawThruster(sf::RenderWindow &window) {
-    if (!has_thrust())
-      return;
-
-    sf::Vector2f pos = body->getPosition();
-    float rotatedAngle = angle + 180.0f;
-    float rad = rotatedAngle * (3.14159f / 180.0f);
-    sf::Vector2f perpendicular(-std::sin(rad), std::cos(rad));
-
-    // NOZZLE
-    float nLen = 8.0f;
-    float nWid = 6.0f;
-    sf::ConvexShape nozzle;
-    nozzle.setPointCount(4);
-    sf::Vector2f nOffset(std::cos(rad) * nLen, std::sin(rad) * nLen);
-
-    nozzle.setPoint(0, pos + perpendicular * nWid);
-    nozzle.setPoint(1, pos - perpendicular * nWid);
-    nozzle.setPoint(2, pos + nOffset - perpendicular * (nWid * 0.8f));
-    nozzle.setPoint(3, pos + nOffset + perpendicular * (nWid * 0.8f));
-
-    if (isCurrentlyThrusting) {
-      nozzle.setFillColor(sf::Color(100, 100, 110)); // Active grey
-    } else {
-      nozzle.setFillColor(sf::Color(30, 30, 35)); // Cold dark grey
-    }
-    window.draw(nozzle);
-
-    if (isCurrentlyThrusting) {
-      float tRatio = thrustCapacity / THRUST_CAPACITY_MAX;
-      float maxLen = POINTER_WIDTH * 1.5f * tRatio;
-      float maxWid = 10.0f;
-
-      // Flickering physics
-      static float time = 0.0f;
-      time += 0.4f;
-      float flicker = 0.95f + (std::sin(time) * 0.05f);
-
-      sf::Color pColor = (currentShipState < 2) ? sf::Color(0, 255, 255)
-                                                : sf::Color(255, 100, 0);
-
-      // Three-layer bloom/glow
-      for (int i = 3; i > 0; i--) {
-        sf::ConvexShape plume;
-        plume.setPointCount(4);
-        float s = i * 0.33f;
-        float l = maxLen * s * flicker;
-        float w = maxWid * s;
-
-        sf::Vector2f tip(std::cos(rad) * l, std::sin(rad) * l);
-        plume.setPoint(0, pos + perpendicular * w);
-        plume.setPoint(1, pos - perpendicular * w);
-        plume.setPoint(2, pos + tip);
-        plume.setPoint(3, pos + tip);
-
-        sf::Color c = pColor;
-        c.a = static_cast<std::uint8_t>(80 / i);
-        plume.setFillColor(c);
-        window.draw(plume);
-      }
-
-      // High-intensity plasma core
-      sf::ConvexShape core;
-      core.setPointCount(3);
-      core.setPoint(0, pos + perpendicular * (maxWid * 0.3f));
-      core.setPoint(1, pos - perpendicular * (maxWid * 0.3f));
-      core.setPoint(2, pos + sf::Vector2f(std::cos(rad) * (maxLen * 0.4f),
-                                          std::sin(rad) * (maxLen * 0.4f)));
-      core.setFillColor(sf::Color::White);
-      window.draw(core);
-    } else {
-      sf::CircleShape dot(2.0f);
-      dot.setOrigin({2.0f, 2.0f});
-      dot.setPosition(pos + nOffset * 0.6f);
-      dot.setFillColor(sf::Color(80, 80, 80, 100));
-      window.draw(dot);
-    }
-  }
-
-  void reset_state() {
-    velocity = {0.f, 0.f};
-    angle = 0.0f;
-    angularVelocity = static_cast<float>((rand() % 100) + 50);
-    rotationSpeed = ROTATION_SPEED;
-    thrustCapacity = THRUST_CAPACITY_MAX;
-    thrustDrainRate = THRUST_DRAIN_RATE;
-    isDead = false;
-    currentShipState = 0;
-    body->setTexture(texHealthy);
-    body->setRotation(sf::degrees(0.f));
-  }
-
-  void draw(sf::RenderWindow &window) {
-    drawThruster(window);
-    window.draw(*body);
+  float getRadius() const { return tuning.astroRadius; }
+  sf::Vector2f getPosition() const { return position; }
+
+  // Back to the freshly constructed state. One reset for both first start
+  // and restart, so the two can never drift apart again.
+  void reset(float spin) {
+    *this = Astronaut();
+    angularVelocity = spin;
   }
 };
 
@@ -1,12 +1,53 @@
 #ifndef AUDIOMANAGER_HPP
 #define AUDIOMANAGER_HPP
 
+#include "AssetLoader.hpp"
+#include "Config.hpp"
 #include "Constants.h"
+#include "SpscQueue.hpp"
+#include "VoicePool.hpp"
 #include <SFML/Audio.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <thread>
+#include <vector>
 
+// One request from the game loop to the audio thread; plain data so it can
+// cross the lock-free queue by copy
+struct AudioCommand {
+  enum Type : std::uint8_t {
+    CreateSources, // Buffers are decoded; build the sf::Sound objects
+    StartMusic,
+    ThrustOn,
+    ThrustOff,
+    Collision,      // A new ship contact began at (x, y)
+    AsteroidImpact, // Asteroids collided at (x, y); value = impulse
+    Oxygen,         // value = current oxygen, drives breathing and SOS
+    Death,
+    GameOver,
+    Victory,
+    StopAll,
+    Restart,
+  };
+  Type type;
+  float value = 0.0f;
+  float x = 0.0f; // Offset from the listener (screen center), px
+  float y = 0.0f;
+};
+
+// All SFML audio objects live on a dedicated thread. The game loop only
+// pushes AudioCommands into a single-producer/single-consumer ring and
+// never blocks on the audio backend; a full queue drops the command (and
+// state changes are retried on the next frame).
 class AudioManager {
 private:
   // Long-duration looping audio buffers
@@ -25,27 +66,72 @@ private:
   sf::SoundBuffer impactBuffer;
   sf::SoundBuffer metalImpactBuffer;
 
-  // Audio source instances
+  // Looping sources keep a dedicated sf::Sound each
   std::unique_ptr<sf::Sound> thrustSound;
-  std::unique_ptr<sf::Sound> collisionSound;
   std::unique_ptr<sf::Sound> breathingSound;
-  std::unique_ptr<sf::Sound> deathScreamSound;
-  std::unique_ptr<sf::Sound> gameOverSound;
-  std::unique_ptr<sf::Sound> victorySound;
-  std::unique_ptr<sf::Sound> warpSound;
   std::unique_ptr<sf::Sound> sosSound;
-  std::unique_ptr<sf::Sound> impactSound;
-  std::unique_ptr<sf::Sound> metalImpactSound;
 
+  // One-shot effects share these voices
+  VoicePool voices;
+  std::vector<const sf::SoundBuffer *> readyBuffers; // Decoded one-shots
+
+  // Who wins when every voice is busy
+  enum Priority { AmbientImpact, ShipImpact, GameEvent };
+
+  // One buffer, its source (null for one-shots) and playback settings
+  struct Clip {
+    const char *path;
+    sf::SoundBuffer *buffer;
+    std::unique_ptr<sf::Sound> *sound;
+    float volume;
+    bool looping;
+  };
+
+  std::vector<Clip> clips() {
+    std::vector<Clip> table = {
+        {SOUND_THRUST_HISS, &thrustBuffer, &thrustSound, 40.0f, true},
+        {SOUND_COLLISION, &collisionBuffer, nullptr, 40.0f, false},
+        {SOUND_BREATHING, &breathingBuffer, &breathingSound, 70.0f, true},
+        {SOUND_IMPACT, &impactBuffer, nullptr, 40.0f, false},
+        {SOUND_METAL_IMPACT, &metalImpactBuffer, nullptr, 40.0f, false},
+        {SOUND_DEATH_SCREAM, &deathScreamBuffer, nullptr, 100.0f, false},
+        {SOUND_GAME_OVER, &gameOverBuffer, nullptr, 70.0f, false},
+        {SOUND_VICTORY, &victoryBuffer, nullptr, 80.0f, false},
+        {SOUND_WARP, &warpBuffer, nullptr, 70.0f, false},
+        {SOUND_SOS, &sosBuffer, &sosSound, 50.0f, true}};
+    // Paths may be overridden by the config
+    for (Clip &clip : table)
+      clip.path = config.asset(clip.path);
+    return table;
+  }
+
+  std::vector<std::future<bool>> pendingClips;
+  std::vector<std::uint8_t> clipLoaded; // Filled before CreateSources
+  bool decoded = false; // Buffers ready; only CreateSources is left to send
+  bool loaded = false;
+
+  // Main-thread view of what has been sent, so state changes are only
+  // queued when they happen
+  bool thrustSent = false;
+  bool contactSent = false;
+  int bandSent = -1;
+  long droppedCommands = 0; // Pushes refused by a full queue
+
+  // Audio-thread state
   bool isBreathingPlaying = false;
   bool isSosPlaying = false;
   bool hasPlayedDeathScream = false;
 
+  SpscQueue<AudioCommand, AUDIO_QUEUE_CAPACITY> commands;
+  std::atomic<bool> running{true};
+  std::thread worker; // Last member: starts once everything above exists
+
 public:
   AudioManager() {
     backgroundMusic.emplace();
-    if (!backgroundMusic->openFromFile(SOUND_BACKGROUND)) {
-      std::cerr << "Warning: Could not load " << SOUND_BACKGROUND << std::endl;
+    if (!backgroundMusic->openFromFile(config.asset(SOUND_BACKGROUND))) {
+      std::cerr << "Warning: Could not load "
+                << config.asset(SOUND_BACKGROUND) << std::endl;
       backgroundMusic.reset();
     } else {
       backgroundMusic->setLooping(true);
@@ -53,129 +139,296 @@ public:
     }
 
     scaryBackgroundMusic.emplace();
-    if (!scaryBackgroundMusic->openFromFile(SOUND_BACKGROUND_SCARY)) {
-      std::cerr << "Warning: Could not load " << SOUND_BACKGROUND_SCARY
-                << std::endl;
+    if (!scaryBackgroundMusic->openFromFile(
+            config.asset(SOUND_BACKGROUND_SCARY))) {
+      std::cerr << "Warning: Could not load "
+                << config.asset(SOUND_BACKGROUND_SCARY) << std::endl;
       scaryBackgroundMusic.reset();
     } else {
       scaryBackgroundMusic->setLooping(true);
       scaryBackgroundMusic->setVolume(35.0f);
     }
 
-    // Initialize sound buffers and sources
-    if (thrustBuffer.loadFromFile(SOUND_THRUST_HISS)) {
-      thrustSound = std::make_unique<sf::Sound>(thrustBuffer);
-      thrustSound->setLooping(true);
-      thrustSound->setVolume(40.0f);
-    } else {
-      std::cerr << "Warning: Could not load " << SOUND_THRUST_HISS << std::endl;
-    }
+    worker = std::thread([this] { audioLoop(); });
+  }
 
-    if (collisionBuffer.loadFromFile(SOUND_COLLISION)) {
-      collisionSound = std::make_unique<sf::Sound>(collisionBuffer);
-      collisionSound->setVolume(40.0f);
-    } else {
-      std::cerr << "Warning: Could not load " << SOUND_COLLISION << std::endl;
-    }
+  ~AudioManager() {
+    running.store(false, std::memory_order_release);
+    worker.join();
+  }
 
-    if (breathingBuffer.loadFromFile(SOUND_BREATHING)) {
-      breathingSound = std::make_unique<sf::Sound>(breathingBuffer);
-      breathingSound->setLooping(true);
-      breathingSound->setVolume(70.0f);
-    } else {
-      std::cerr << "Warning: Could not load " << SOUND_BREATHING << std::endl;
-    }
+  AudioManager(const AudioManager &) = delete;
+  AudioManager &operator=(const AudioManager &) = delete;
 
-    if (impactBuffer.loadFromFile(SOUND_IMPACT)) {
-      impactSound = std::make_unique<sf::Sound>(impactBuffer);
-      impactSound->setVolume(40.0f);
-    } else {
-      std::cerr << "Warning: Could not load " << SOUND_IMPACT << std::endl;
+  // Queue every sound buffer for decoding on the loader's workers
+  void requestAssets(AssetLoader &loader) {
+    for (const Clip &clip : clips()) {
+      sf::SoundBuffer *buffer = clip.buffer;
+      const char *path = clip.path;
+      pendingClips.push_back(loader.add(
+          [buffer, path] { return buffer->loadFromFile(path); }));
     }
+  }
 
-    if (metalImpactBuffer.loadFromFile(SOUND_METAL_IMPACT)) {
-      metalImpactSound = std::make_unique<sf::Sound>(metalImpactBuffer);
-      metalImpactSound->setVolume(40.0f);
-    } else {
-      std::cerr << "Warning: Could not load " << SOUND_METAL_IMPACT
-                << std::endl;
-    }
+  // Call once per frame on the main thread. Once every buffer is decoded,
+  // asks the audio thread to create the sound sources and returns true from
+  // then on. Without requestAssets the buffers are loaded synchronously
+  // here. If the queue is full, later calls only retry the send.
+  bool finishLoading() {
+    if (loaded)
+      return true;
+    if (!decoded) {
+      for (const auto &result : pendingClips)
+        if (result.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready)
+          return false;
 
-    if (deathScreamBuffer.loadFromFile(SOUND_DEATH_SCREAM)) {
-      deathScreamSound = std::make_unique<sf::Sound>(deathScreamBuffer);
-      deathScreamSound->setVolume(100.0f);
-    } else {
-      std::cerr << "Warning: Could not load " << SOUND_DEATH_SCREAM
-                << std::endl;
+      bool queued = !pendingClips.empty();
+      std::vector<Clip> all = clips();
+      clipLoaded.assign(all.size(), 0);
+      for (size_t i = 0; i < all.size(); i++) {
+        const Clip &clip = all[i];
+        clipLoaded[i] = queued ? pendingClips[i].get()
+                               : clip.buffer->loadFromFile(clip.path);
+        if (!clipLoaded[i])
+          std::cerr << "Warning: Could not load " << clip.path << std::endl;
+      }
+      pendingClips.clear();
+      decoded = true;
     }
+    // The buffers and flags above are published by the queue's release
+    loaded = send({AudioCommand::CreateSources});
+    return loaded;
+  }
 
-    if (gameOverBuffer.loadFromFile(SOUND_GAME_OVER)) {
-      gameOverSound = std::make_unique<sf::Sound>(gameOverBuffer);
-      gameOverSound->setVolume(70.0f);
-    } else {
-      std::cerr << "Warning: Could not load " << SOUND_GAME_OVER << std::endl;
-    }
+  // The game-facing calls below only queue commands: they never touch
+  // SFML and never wait for the audio thread. State (thrust, contact) is
+  // sent on change and re-sent next frame if the queue was full.
 
-    if (victoryBuffer.loadFromFile(SOUND_VICTORY)) {
-      victorySound = std::make_unique<sf::Sound>(victoryBuffer);
-      victorySound->setVolume(80.0f);
-    } else {
-      std::cerr << "Warning: Could not load " << SOUND_VICTORY << std::endl;
-    }
+  void startBackgroundMusic() { send({AudioCommand::StartMusic}); }
 
-    if (warpBuffer.loadFromFile(SOUND_WARP)) {
-      warpSound = std::make_unique<sf::Sound>(warpBuffer);
-      warpSound->setVolume(70.0f);
-    } else {
-      std::cerr << "Warning: Could not load " << SOUND_WARP << std::endl;
-    }
+  void playThrust() { setThrust(true); }
 
-    if (sosBuffer.loadFromFile(SOUND_SOS)) {
-      sosSound = std::make_unique<sf::Sound>(sosBuffer);
-      sosSound->setLooping(true);
-      sosSound->setVolume(50.0f);
-    } else {
-      std::cerr << "Warning: Could not load " << SOUND_SOS << std::endl;
+  void stopThrust() { setThrust(false); }
+
+  // Pass whether the ship touched an asteroid this frame and where it is
+  // relative to the screen center; the impact sounds play once when a
+  // contact begins, not every frame it lasts
+  void updateContact(bool touching, sf::Vector2f offset) {
+    if (touching == contactSent)
+      return;
+    if (!touching ||
+        send({AudioCommand::Collision, 0.0f, offset.x, offset.y}))
+      contactSent = touching;
+  }
+
+  // An asteroid-asteroid impact; volume follows the impulse and the
+  // distance from the screen center, pan the horizontal offset
+  void playImpact(sf::Vector2f offset, float impulse) {
+    send({AudioCommand::AsteroidImpact, impulse, offset.x, offset.y});
+  }
+
+  // Only crossing a threshold changes what plays, so the level is sent
+  // when its band changes rather than every frame
+  void updateBreathing(float oxygen) {
+    int band = oxygenBand(oxygen);
+    if (band != bandSent && send({AudioCommand::Oxygen, oxygen}))
+      bandSent = band;
+  }
+
+  void playDeath() { send({AudioCommand::Death}); }
+
+  void playGameOver() { send({AudioCommand::GameOver}); }
+
+  void playVictory() { send({AudioCommand::Victory}); }
+
+  void stopAll() {
+    if (send({AudioCommand::StopAll})) {
+      thrustSent = false;
+      bandSent = -1;
     }
   }
 
-  void startBackgroundMusic() {
-    if (backgroundMusic &&
-        backgroundMusic->getStatus() != sf::SoundSource::Status::Playing) {
-      backgroundMusic->play();
+  void resetForRestart() {
+    if (send({AudioCommand::Restart})) {
+      thrustSent = false;
+      contactSent = false;
+      bandSent = -1;
     }
   }
 
-  void playThrust() {
-    if (thrustSound &&
-        thrustSound->getStatus() != sf::SoundSource::Status::Playing) {
-      thrustSound->play();
+  long dropped() const { return droppedCommands; }
+
+  // Voice usage so far, for sizing AUDIO_VOICES
+  void report(std::ostream &out) const {
+    voices.report(out);
+    out << "Audio commands dropped: " << droppedCommands << std::endl;
+  }
+
+private:
+  bool send(AudioCommand command) {
+    if (commands.push(command))
+      return true;
+    droppedCommands++;
+    return false;
+  }
+
+  // Which of the comparisons in applyOxygen hold; equal bands play the same
+  static int oxygenBand(float oxygen) {
+    return (oxygen < tuning.lowOxygenThreshold) |
+           (oxygen > tuning.lowOxygenThreshold) << 1 |
+           (oxygen < tuning.criticalOxygenThreshold) << 2 |
+           (oxygen > tuning.criticalOxygenThreshold) << 3 |
+           (oxygen > 0) << 4;
+  }
+
+  void setThrust(bool on) {
+    if (on != thrustSent &&
+        send({on ? AudioCommand::ThrustOn : AudioCommand::ThrustOff}))
+      thrustSent = on;
+  }
+
+  // Drains the queue in batches. Within a batch only the newest oxygen
+  // level is applied and a burst of collisions plays once, so a backlog
+  // after a stall is not replayed note by note.
+  void audioLoop() {
+    std::array<AudioCommand, AUDIO_QUEUE_CAPACITY> batch;
+    while (true) {
+      // Read the flag first so commands queued before shutdown still run
+      bool stopping = !running.load(std::memory_order_acquire);
+      voices.update();
+      size_t count = 0;
+      while (count < batch.size() && commands.pop(batch[count]))
+        count++;
+      if (count == 0) {
+        if (stopping)
+          return;
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(AUDIO_THREAD_POLL_MS));
+        continue;
+      }
+
+      size_t lastOxygen = count;
+      for (size_t i = 0; i < count; i++)
+        if (batch[i].type == AudioCommand::Oxygen)
+          lastOxygen = i;
+      bool collided = false;
+      for (size_t i = 0; i < count; i++) {
+        const AudioCommand &command = batch[i];
+        if (command.type == AudioCommand::Oxygen && i != lastOxygen)
+          continue;
+        if (command.type == AudioCommand::Collision) {
+          if (collided)
+            continue;
+          collided = true;
+        }
+        execute(command);
+      }
     }
   }
 
-  void stopThrust() {
-    if (thrustSound &&
-        thrustSound->getStatus() == sf::SoundSource::Status::Playing) {
-      thrustSound->stop();
+  void execute(const AudioCommand &command) {
+    switch (command.type) {
+    case AudioCommand::CreateSources:
+      createSources();
+      break;
+    case AudioCommand::StartMusic:
+      if (backgroundMusic &&
+          backgroundMusic->getStatus() != sf::SoundSource::Status::Playing)
+        backgroundMusic->play();
+      break;
+    case AudioCommand::ThrustOn:
+      if (thrustSound &&
+          thrustSound->getStatus() != sf::SoundSource::Status::Playing)
+        thrustSound->play();
+      break;
+    case AudioCommand::ThrustOff:
+      if (thrustSound)
+        thrustSound->stop();
+      break;
+    case AudioCommand::Collision: {
+      float pan = panFor(command);
+      playEffect(collisionBuffer, ShipImpact, 40.0f, pan);
+      playEffect(impactBuffer, ShipImpact, 40.0f, pan);
+      playEffect(metalImpactBuffer, ShipImpact, 40.0f, pan);
+      break;
+    }
+    case AudioCommand::AsteroidImpact: {
+      float strength =
+          std::min(1.0f, command.value / AUDIO_IMPACT_FULL_IMPULSE);
+      float distance = std::hypot(command.x, command.y);
+      float volume =
+          40.0f * strength / (1.0f + distance / AUDIO_FALLOFF_DISTANCE);
+      if (volume >= AUDIO_MIN_VOLUME)
+        playEffect(impactBuffer, AmbientImpact, volume, panFor(command));
+      break;
+    }
+    case AudioCommand::Oxygen:
+      applyOxygen(command.value);
+      break;
+    case AudioCommand::Death:
+      if (!hasPlayedDeathScream) {
+        playEffect(deathScreamBuffer, GameEvent, 100.0f, 0.0f);
+        hasPlayedDeathScream = true;
+      }
+      break;
+    case AudioCommand::GameOver:
+      playEffect(gameOverBuffer, GameEvent, 70.0f, 0.0f);
+      break;
+    case AudioCommand::Victory:
+      playEffect(victoryBuffer, GameEvent, 80.0f, 0.0f);
+      playEffect(warpBuffer, GameEvent, 70.0f, 0.0f);
+      break;
+    case AudioCommand::StopAll:
+      stopSources();
+      break;
+    case AudioCommand::Restart:
+      stopSources();
+      hasPlayedDeathScream = false;
+      if (backgroundMusic)
+        backgroundMusic->play();
+      break;
     }
   }
 
-  void playCollision() {
-    if (collisionSound) {
-      collisionSound->play();
-      impactSound->play();
-      metalImpactSound->play();
+  void createSources() {
+    std::vector<Clip> all = clips();
+    for (size_t i = 0; i < all.size(); i++) {
+      const Clip &clip = all[i];
+      if (!clipLoaded[i])
+        continue;
+      if (!clip.sound) {
+        readyBuffers.push_back(clip.buffer);
+        continue;
+      }
+      *clip.sound = std::make_unique<sf::Sound>(*clip.buffer);
+      (*clip.sound)->setLooping(clip.looping);
+      (*clip.sound)->setVolume(clip.volume);
     }
+    if (!readyBuffers.empty())
+      voices.init(*readyBuffers.front());
   }
 
-  void updateBreathing(float oxygen) {
+  void playEffect(const sf::SoundBuffer &buffer, int priority, float volume,
+                  float pan) {
+    if (std::find(readyBuffers.begin(), readyBuffers.end(), &buffer) !=
+        readyBuffers.end())
+      voices.play(buffer, priority, volume, pan);
+  }
+
+  static float panFor(const AudioCommand &command) {
+    return std::clamp(command.x / AUDIO_PAN_DISTANCE, -1.0f, 1.0f);
+  }
+
+  void applyOxygen(float oxygen) {
     // Trigger rhythmic audio based on oxygen levels
-    if (oxygen < LOW_OXYGEN_THRESHOLD && oxygen > CRITICAL_OXYGEN_THRESHOLD) {
+    if (oxygen < tuning.lowOxygenThreshold &&
+        oxygen > tuning.criticalOxygenThreshold) {
       if (!isBreathingPlaying && breathingSound) {
         breathingSound->play();
         isBreathingPlaying = true;
       }
-    } else if (oxygen > LOW_OXYGEN_THRESHOLD) {
+    } else if (oxygen > tuning.lowOxygenThreshold) {
       if (isBreathingPlaying && breathingSound) {
         breathingSound->stop();
         isBreathingPlaying = false;
@@ -183,7 +436,7 @@ public:
     }
 
     // Critical state: SOS modulation
-    if (oxygen < CRITICAL_OXYGEN_THRESHOLD && oxygen > 0) {
+    if (oxygen < tuning.criticalOxygenThreshold && oxygen > 0) {
       if (!isSosPlaying) {
         if (sosSound)
           sosSound->play();
@@ -197,7 +450,7 @@ public:
           scaryBackgroundMusic->play();
         }
       }
-    } else if (oxygen > CRITICAL_OXYGEN_THRESHOLD) {
+    } else if (oxygen > tuning.criticalOxygenThreshold) {
       if (isSosPlaying && sosSound) {
         sosSound->stop();
         isSosPlaying = false;
@@ -205,26 +458,7 @@ public:
     }
   }
 
-  void playDeath() {
-    if (!hasPlayedDeathScream && deathScreamSound) {
-      deathScreamSound->play();
-      hasPlayedDeathScream = true;
-    }
-  }
-
-  void playGameOver() {
-    if (gameOverSound)
-      gameOverSound->play();
-  }
-
-  void playVictory() {
-    if (victorySound)
-      victorySound->play();
-    if (warpSound)
-      warpSound->play();
-  }
-
-  void stopAll() {
+  void stopSources() {
     if (thrustSound)
       thrustSound->stop();
     if (breathingSound)
@@ -238,12 +472,6 @@ public:
     isBreathingPlaying = false;
     isSosPlaying = false;
   }
-
-  void resetForRestart() {
-    stopAll();
-    hasPlayedDeathScream = false;
-    startBackgroundMusic();
-  }
 };
 
 #endif
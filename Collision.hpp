@@ -0,0 +1,204 @@
+#ifndef COLLISION_HPP
+#define COLLISION_HPP
+
+#include "Astronaut.hpp"
+#include "Config.hpp"
+#include "Constants.h"
+#include "ObstacleField.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <cmath>
+
+// One side of a disc contact: references into the body's state plus the
+// constants the impulse needs
+struct ContactBody {
+  float &vx;
+  float &vy;
+  float &angularVelocity; // deg/s
+  float invMass;
+  float invInertia;
+  float radius;
+};
+
+// Inelastic impact with rotational transfer shared by every disc pair.
+// normal points from B towards A. Returns false (and changes nothing) when
+// the bodies are already separating.
+inline bool applyContactImpulse(ContactBody a, ContactBody b,
+                                sf::Vector2f normal) {
+  // Collision arm vectors from centers to impact point
+  sf::Vector2f rA = normal * a.radius;
+  sf::Vector2f rB = -normal * b.radius;
+
+  // Relative velocity at impact point (including angular components)
+  // v_rel = (vB + wB x rB) - (vA + wA x rA)
+  auto crossZ = [](float w, sf::Vector2f r) {
+    return sf::Vector2f(-w * r.y, w * r.x);
+  };
+  sf::Vector2f vA_total = sf::Vector2f(a.vx, a.vy) +
+                          crossZ(a.angularVelocity * (3.14159f / 180.0f), rA);
+  sf::Vector2f vB_total = sf::Vector2f(b.vx, b.vy) +
+                          crossZ(b.angularVelocity * (3.14159f / 180.0f), rB);
+  sf::Vector2f v_rel = vB_total - vA_total;
+
+  float rel_norm = v_rel.x * normal.x + v_rel.y * normal.y;
+
+  // Only resolve if objects are approaching. normal points from B to A, so
+  // B's velocity relative to A has a positive normal component when closing
+  if (rel_norm <= 0)
+    return false;
+
+  // Linear impulse magnitude (simplified for circular friction-less feel,
+  // but we add tangential later)
+  float e = tuning.collisionBounceFactor;
+  float j = -(1.0f + e) * rel_norm;
+  j /= (a.invMass + b.invMass);
+
+  sf::Vector2f impulse = normal * j;
+
+  // Apply linear impulse
+  a.vx -= impulse.x * a.invMass;
+  a.vy -= impulse.y * a.invMass;
+  b.vx += impulse.x * b.invMass;
+  b.vy += impulse.y * b.invMass;
+
+  // Tangential impulse (Friction/Torque transfer)
+  sf::Vector2f tangent{-normal.y, normal.x};
+  float rel_tan = v_rel.x * tangent.x + v_rel.y * tangent.y;
+  float jt = -rel_tan * tuning.collisionFriction;
+  jt /= (a.invMass + b.invMass);
+
+  sf::Vector2f frictionImpulse = tangent * jt;
+
+  // Apply torque: torque = r x impulse
+  auto cross2D = [](sf::Vector2f r, sf::Vector2f f) {
+    return r.x * f.y - r.y * f.x;
+  };
+
+  float torqueA = cross2D(rA, -frictionImpulse);
+  float torqueB = cross2D(rB, frictionImpulse);
+
+  // Convert torque to angular velocity change: dw = torque / inertia
+  a.angularVelocity += (torqueA * a.invInertia) * (180.0f / 3.14159f);
+  b.angularVelocity += (torqueB * b.invInertia) * (180.0f / 3.14159f);
+  return true;
+}
+
+// Obstacles have simulated inertia (mr^2)
+inline ContactBody contactBody(ObstacleField &field, int i) {
+  float r = field.radius[i];
+  return {field.vx[i], field.vy[i], field.omega[i], field.invMass[i],
+          field.invMass[i] / (r * r), r};
+}
+
+// Velocity change and oxygen loss of a ship hit; normal points from the
+// obstacle towards the ship
+inline void applyShipImpact(Astronaut &a, ObstacleField &field, int i,
+                            sf::Vector2f normal) {
+  // Dynamic resolution; Astronaut has explicit inertia
+  ContactBody ship{a.velocity.x, a.velocity.y, a.angularVelocity,
+                   1.0f / a.mass, 1.0f / a.inertia, a.getRadius()};
+  if (applyContactImpulse(ship, contactBody(field, i), normal)) {
+    // Momentum transfer from obstacle scale
+    a.velocity += field.velocity(i) * tuning.collisionKickFactor;
+  }
+
+  float velocityMagnitude =
+      std::sqrt(a.velocity.x * a.velocity.x + a.velocity.y * a.velocity.y);
+  if (velocityMagnitude > 10) {
+    float oxygen_drain = velocityMagnitude * a.collisionDrainFactor;
+    a.deplet_oxygen(oxygen_drain);
+  }
+}
+
+// Shortest offset on a periodic axis (toroidal world)
+inline float wrapDelta(float delta, float period) {
+  if (delta > period * 0.5f)
+    return delta - period;
+  if (delta < -period * 0.5f)
+    return delta + period;
+  return delta;
+}
+
+// Shortest offset between two points in the toroidal world, so contacts
+// across the wrap seam are found and pushed apart the short way
+inline sf::Vector2f wrapOffset(sf::Vector2f delta) {
+  return {wrapDelta(delta.x, tuning.worldWidth),
+          wrapDelta(delta.y, tuning.worldHeight)};
+}
+
+// Time of impact of two circles moving linearly over one step.
+// start is A - B at the beginning of the step, motion is A's displacement
+// relative to B. Returns true with toi in [0, 1) when they first touch
+// during the step; circles already overlapping at the start are left to
+// the discrete path.
+inline bool sweptCircleTOI(sf::Vector2f start, sf::Vector2f motion,
+                           float radiusSum, float &toi) {
+  float c = start.x * start.x + start.y * start.y - radiusSum * radiusSum;
+  if (c <= 0.f)
+    return false;
+  float a = motion.x * motion.x + motion.y * motion.y;
+  float b = 2.0f * (start.x * motion.x + start.y * motion.y);
+  if (b >= 0.f || a <= 0.f) // Not approaching
+    return false;
+  float discriminant = b * b - 4.0f * a * c;
+  if (discriminant < 0.f)
+    return false;
+  float t = (-b - std::sqrt(discriminant)) / (2.0f * a);
+  if (t >= 1.0f)
+    return false;
+  toi = t;
+  return true;
+}
+
+// Returns true when the astronaut and obstacle i overlap
+inline bool handleCollision(Astronaut &a, ObstacleField &field, int i) {
+  sf::Vector2f diff = wrapOffset(a.getPosition() - field.position(i));
+  float distanceSq = diff.x * diff.x + diff.y * diff.y;
+  float minDistance = a.getRadius() + field.radius[i];
+
+  // Reject misses before paying for the square root
+  if (distanceSq >= minDistance * minDistance)
+    return false;
+
+  // Coincident centers: pick a fixed axis rather than dividing by zero
+  float distance = std::sqrt(distanceSq);
+  sf::Vector2f normal =
+      (distance > 0.f) ? diff / distance : sf::Vector2f(1.f, 0.f);
+
+  // Static resolution: correction for overlap
+  float overlap = minDistance - distance;
+  a.position += normal * overlap;
+
+  applyShipImpact(a, field, i, normal);
+  return true;
+}
+
+// Asteroid-vs-asteroid contact with the same restitution/friction model.
+// Overlap is split by inverse mass. Returns true when the pair overlaps.
+inline bool resolveObstaclePair(ObstacleField &field, int a, int b) {
+  sf::Vector2f diff = wrapOffset(field.position(a) - field.position(b));
+  float distanceSq = diff.x * diff.x + diff.y * diff.y;
+  float minDistance = field.radius[a] + field.radius[b];
+
+  if (distanceSq >= minDistance * minDistance)
+    return false;
+
+  // Coincident centers: pick a fixed axis rather than dividing by zero
+  float distance = std::sqrt(distanceSq);
+  sf::Vector2f normal =
+      (distance > 0.f) ? diff / distance : sf::Vector2f(1.f, 0.f);
+
+  // Static resolution: heavier bodies move less
+  float overlap = minDistance - distance;
+  float invA = field.invMass[a];
+  float invB = field.invMass[b];
+  float share = overlap / (invA + invB);
+  field.x[a] += normal.x * (share * invA);
+  field.y[a] += normal.y * (share * invA);
+  field.x[b] -= normal.x * (share * invB);
+  field.y[b] -= normal.y * (share * invB);
+
+  applyContactImpulse(contactBody(field, a), contactBody(field, b), normal);
+  return true;
+}
+
+#endif
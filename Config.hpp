@@ -0,0 +1,315 @@
+#ifndef CONFIG_HPP
+#define CONFIG_HPP
+
+#include "Constants.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+
+// Gameplay and physics tunables. Defaults are the Constants.h macros; a
+// config file or --set flags can override them at startup, so parameter
+// sweeps need no rebuild. Hot code reads plain members of the global
+// `tuning` (one load, no lookup). Building with -DCONFIG_COMPILED_IN=1
+// makes `tuning` constexpr, so the compiler folds the defaults in as
+// literals exactly like the old macros and overrides are rejected.
+struct Tuning {
+  // Window
+  int windowWidth = WINDOW_WIDTH;
+  int windowHeight = WINDOW_HEIGHT;
+  int framerateLimit = FRAMERATE_LIMIT;
+
+  // World; wraps at its edges. Larger than the window, the camera follows
+  // the ship and asteroids are streamed by chunk (ObstacleChunks.hpp)
+  int worldWidth = WORLD_WIDTH;
+  int worldHeight = WORLD_HEIGHT;
+
+  // Astronaut
+  float astroRadius = ASTRO_RADIUS;
+  float rotationSpeed = ROTATION_SPEED;
+  float thrustPower = THRUST_POWER;
+  float oxygenMax = OXYGEN_MAX;
+  float oxygenDrainNormal = OXYGEN_DRAIN_NORMAL;
+  float oxygenDrainCollision = OXYGEN_DRAIN_COLLISION;
+  float thrustCapacityMax = THRUST_CAPACITY_MAX;
+  float thrustDrainRate = THRUST_DRAIN_RATE;
+  float astroMass = ASTRO_MASS;
+  float astroInertia = ASTRO_INERTIA;
+  float angularDamping = ANGULAR_DAMPING;
+  float minAngularVelocity = MIN_ANGULAR_VELOCITY;
+
+  // Goal
+  float goalRadius = GOAL_RADIUS;
+
+  // Obstacles
+  int numObstacles = NUM_OBSTACLES;
+  int minObstacleRadius = MIN_OBSTACLE_RADIUS;
+  int maxObstacleRadius = MAX_OBSTACLE_RADIUS;
+  float obstacleMassScale = OBSTACLE_MASS_SCALE;
+  int solverThreads = SOLVER_THREADS;
+  float fragmentImpulse = FRAGMENT_IMPULSE;
+  float fragmentMinRadius = FRAGMENT_MIN_RADIUS;
+
+  // Collision response
+  float collisionBounceFactor = COLLISION_BOUNCE_FACTOR;
+  float collisionKickFactor = COLLISION_KICK_FACTOR;
+  float collisionFriction = COLLISION_FRICTION;
+
+  // Thresholds
+  float lowOxygenThreshold = LOW_OXYGEN_THRESHOLD;
+  float criticalOxygenThreshold = CRITICAL_OXYGEN_THRESHOLD;
+  float shipHealthyThreshold = SHIP_HEALTHY_THRESHOLD;
+  float shipDamagedThreshold = SHIP_DAMAGED_THRESHOLD;
+};
+
+#if CONFIG_COMPILED_IN
+inline constexpr Tuning tuning{};
+#else
+inline Tuning tuning;
+#endif
+
+// Loads overrides and maps them onto `tuning` and the asset paths. Keys are
+// the lower-cased names of the macros they replace, e.g. thrust_power or
+// tex_background. Files hold one `key = value` per line; `#` starts a
+// comment.
+class Config {
+public:
+  struct Field {
+    float Tuning::*real; // Exactly one of real/integer is set
+    int Tuning::*integer;
+  };
+
+  static const std::map<std::string, Field> &fields() {
+    static const std::map<std::string, Field> table = {
+        {"window_width", {nullptr, &Tuning::windowWidth}},
+        {"window_height", {nullptr, &Tuning::windowHeight}},
+        {"framerate_limit", {nullptr, &Tuning::framerateLimit}},
+        {"world_width", {nullptr, &Tuning::worldWidth}},
+        {"world_height", {nullptr, &Tuning::worldHeight}},
+        {"astro_radius", {&Tuning::astroRadius, nullptr}},
+        {"rotation_speed", {&Tuning::rotationSpeed, nullptr}},
+        {"thrust_power", {&Tuning::thrustPower, nullptr}},
+        {"oxygen_max", {&Tuning::oxygenMax, nullptr}},
+        {"oxygen_drain_normal", {&Tuning::oxygenDrainNormal, nullptr}},
+        {"oxygen_drain_collision", {&Tuning::oxygenDrainCollision, nullptr}},
+        {"thrust_capacity_max", {&Tuning::thrustCapacityMax, nullptr}},
+        {"thrust_drain_rate", {&Tuning::thrustDrainRate, nullptr}},
+        {"astro_mass", {&Tuning::astroMass, nullptr}},
+        {"astro_inertia", {&Tuning::astroInertia, nullptr}},
+        {"angular_damping", {&Tuning::angularDamping, nullptr}},
+        {"min_angular_velocity", {&Tuning::minAngularVelocity, nullptr}},
+        {"goal_radius", {&Tuning::goalRadius, nullptr}},
+        {"num_obstacles", {nullptr, &Tuning::numObstacles}},
+        {"min_obstacle_radius", {nullptr, &Tuning::minObstacleRadius}},
+        {"max_obstacle_radius", {nullptr, &Tuning::maxObstacleRadius}},
+        {"obstacle_mass_scale", {&Tuning::obstacleMassScale, nullptr}},
+        {"solver_threads", {nullptr, &Tuning::solverThreads}},
+        {"fragment_impulse", {&Tuning::fragmentImpulse, nullptr}},
+        {"fragment_min_radius", {&Tuning::fragmentMinRadius, nullptr}},
+        {"collision_bounce_factor", {&Tuning::collisionBounceFactor, nullptr}},
+        {"collision_kick_factor", {&Tuning::collisionKickFactor, nullptr}},
+        {"collision_friction", {&Tuning::collisionFriction, nullptr}},
+        {"low_oxygen_threshold", {&Tuning::lowOxygenThreshold, nullptr}},
+        {"critical_oxygen_threshold",
+         {&Tuning::criticalOxygenThreshold, nullptr}},
+        {"ship_healthy_threshold", {&Tuning::shipHealthyThreshold, nullptr}},
+        {"ship_damaged_threshold", {&Tuning::shipDamagedThreshold, nullptr}},
+    };
+    return table;
+  }
+
+  // Asset keys and the default paths they override
+  static const std::map<std::string, const char *> &assetKeys() {
+    static const std::map<std::string, const char *> table = {
+        {"tex_background", TEX_BACKGROUND},
+        {"tex_ship_healthy", TEX_SHIP_HEALTHY},
+        {"tex_ship_damaged", TEX_SHIP_DAMAGED},
+        {"tex_ship_broken", TEX_SHIP_BROKEN},
+        {"tex_wormhole", TEX_WORMHOLE},
+        {"tex_asteroid_1", TEX_ASTEROID_1},
+        {"tex_asteroid_2", TEX_ASTEROID_2},
+        {"tex_asteroid_3", TEX_ASTEROID_3},
+        {"tex_asteroid_4", TEX_ASTEROID_4},
+        {"sound_background", SOUND_BACKGROUND},
+        {"sound_background_scary", SOUND_BACKGROUND_SCARY},
+        {"sound_thrust_hiss", SOUND_THRUST_HISS},
+        {"sound_collision", SOUND_COLLISION},
+        {"sound_impact", SOUND_IMPACT},
+        {"sound_metal_impact", SOUND_METAL_IMPACT},
+        {"sound_breathing", SOUND_BREATHING},
+        {"sound_death_scream", SOUND_DEATH_SCREAM},
+        {"sound_game_over", SOUND_GAME_OVER},
+        {"sound_victory", SOUND_VICTORY},
+        {"sound_warp", SOUND_WARP},
+        {"sound_sos", SOUND_SOS},
+        {"font_path", FONT_PATH},
+    };
+    return table;
+  }
+
+  // Path to load for an asset macro, after overrides. Only read at load
+  // time; the returned pointer stays valid while no override is added.
+  const char *asset(const char *defaultPath) const {
+    auto it = assetOverrides.find(defaultPath);
+    return it == assetOverrides.end() ? defaultPath : it->second.c_str();
+  }
+
+  bool set(const std::string &key, const std::string &value) {
+    auto asset = assetKeys().find(key);
+    if (asset != assetKeys().end()) {
+      assetOverrides[asset->second] = value;
+      return true;
+    }
+    auto field = fields().find(key);
+    if (field == fields().end()) {
+      std::cerr << "Error: unknown config key " << key << std::endl;
+      return false;
+    }
+#if CONFIG_COMPILED_IN
+    // Ignoring overrides is this build's purpose, not a mistake
+    std::cerr << "Warning: tuning is compiled in, ignoring " << key
+              << std::endl;
+    return true;
+#else
+    char *end = nullptr;
+    float number = std::strtof(value.c_str(), &end);
+    if (value.empty() || *end != '\0') {
+      std::cerr << "Error: bad value for " << key << ": " << value
+                << std::endl;
+      return false;
+    }
+    if (field->second.real)
+      tuning.*field->second.real = number;
+    else
+      tuning.*field->second.integer = static_cast<int>(number);
+    return true;
+#endif
+  }
+
+  // Missing files are only an error when asked for explicitly. Returns
+  // false on a bad line, after reporting every one.
+  bool load(const std::string &path, bool required) {
+    std::ifstream in(path);
+    if (!in) {
+      if (required)
+        std::cerr << "Error: Could not read config " << path << std::endl;
+      return !required;
+    }
+    std::string line;
+    int lineNumber = 0;
+    bool ok = true;
+    while (std::getline(in, line)) {
+      lineNumber++;
+      line = trim(line.substr(0, line.find('#')));
+      if (line.empty())
+        continue;
+      size_t equals = line.find('=');
+      if (equals == std::string::npos) {
+        std::cerr << "Error: " << path << ":" << lineNumber
+                  << ": expected key = value" << std::endl;
+        ok = false;
+        continue;
+      }
+      if (!set(trim(line.substr(0, equals)), trim(line.substr(equals + 1)))) {
+        std::cerr << "  in " << path << ":" << lineNumber << std::endl;
+        ok = false;
+      }
+    }
+    return ok;
+  }
+
+  // Applies CONFIG_DEFAULT_PATH if present, then --config FILE and
+  // --set KEY=VALUE in command-line order, and removes those arguments so
+  // each driver only sees its own. --print-config writes the effective
+  // configuration to stdout. Returns false when the program should exit,
+  // with exitCode 0 after --print-config and 1 when a config file could not
+  // be read or a key or value was bad (all errors are reported first).
+  bool init(int &argc, char *argv[], int &exitCode) {
+    bool valid = load(CONFIG_DEFAULT_PATH, false);
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+      if (std::strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+        valid = load(argv[++i], true) && valid;
+      } else if (std::strcmp(argv[i], "--set") == 0 && i + 1 < argc) {
+        std::string assignment = argv[++i];
+        size_t equals = assignment.find('=');
+        if (equals == std::string::npos) {
+          std::cerr << "Error: --set expects KEY=VALUE, got " << assignment
+                    << std::endl;
+          valid = false;
+        } else {
+          valid = set(assignment.substr(0, equals),
+                      assignment.substr(equals + 1)) &&
+                  valid;
+        }
+      } else if (std::strcmp(argv[i], "--print-config") == 0) {
+        printRequested = true;
+      } else {
+        argv[kept++] = argv[i];
+      }
+    }
+    argc = kept;
+    exitCode = valid ? 0 : 1;
+    if (!valid)
+      return false;
+    if (printRequested) {
+      write(std::cout);
+      return false;
+    }
+    return true;
+  }
+
+  // Every key with its current value, in the file format load() reads
+  void write(std::ostream &out) const {
+    for (const auto &entry : fields()) {
+      const Field &field = entry.second;
+      out << entry.first << " = ";
+      if (field.real)
+        out << tuning.*field.real << "\n";
+      else
+        out << tuning.*field.integer << "\n";
+    }
+    for (const auto &entry : assetKeys())
+      out << entry.first << " = " << asset(entry.second) << "\n";
+  }
+
+  // FNV-1a over the tuning values, stored in replays so a session is not
+  // silently re-run under different physics
+  static std::uint64_t hash() {
+    std::uint64_t h = 14695981039346656037ull;
+    for (const auto &entry : fields()) {
+      const Field &field = entry.second;
+      std::uint32_t bits;
+      if (field.real) {
+        float value = tuning.*field.real;
+        std::memcpy(&bits, &value, sizeof bits);
+      } else {
+        bits = static_cast<std::uint32_t>(tuning.*field.integer);
+      }
+      for (int b = 0; b < 4; b++) {
+        h ^= (bits >> (8 * b)) & 0xff;
+        h *= 1099511628211ull;
+      }
+    }
+    return h;
+  }
+
+private:
+  std::map<std::string, std::string> assetOverrides; // default path -> file
+  bool printRequested = false;
+
+  static std::string trim(const std::string &text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos)
+      return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+  }
+};
+
+inline Config config;
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
-#include <SFML/Graphics.hpp>
+#include <SFML/Graphics/Color.hpp>
 
 // Window
 #define WINDOW_WIDTH 1200
@@ -10,6 +10,14 @@
 #define FRAMERATE_LIMIT 60
 #define BACKGROUND_COLOR sf::Color(5, 5, 15)
 
+// World
+#define WORLD_WIDTH WINDOW_WIDTH // Larger values enable large-world mode
+#define WORLD_HEIGHT WINDOW_HEIGHT
+#define CHUNK_SIZE 1024.0f     // Target chunk edge, adjusted to tile the world
+#define CHUNK_ACTIVE_RADIUS 2  // Chunks around the ship's that simulate fully
+#define CHUNK_SWEEP_SECONDS 10 // Each dormant chunk is refiled this often
+#define CAMERA_CULL_MARGIN 1.5f // Sprite half-extent slack when culling
+
 // Astronaut
 #define ASTRO_RADIUS 25.0f
 #define ASTRO_START_POS_X WINDOW_WIDTH * 0.1f
@@ -34,7 +42,7 @@
 #define THRUST_DRAIN_RATE 20.0f
 #define ASTRO_MASS 1.0f
 #define ASTRO_INERTIA 500.0f       // Rotational resistance
-#define ANGULAR_DAMPING 0.99f      // Friction for rotation
+#define ANGULAR_DAMPING 0.547f     // Rotation kept per second (0.99 per 60 Hz frame)
 #define MIN_ANGULAR_VELOCITY 40.0f // Minimum rotation to prevent stall
 
 // HUD
@@ -63,15 +71,89 @@
 #define OBSTACLE_OUTLINE_COLOR sf::Color(150, 150, 150)
 #define OBSTACLE_OUTLINE_THICKNESS 2.0f
 #define NUM_OBSTACLES 10
+#define NUM_ASTEROID_TEXTURES 4
 #define MIN_OBSTACLE_RADIUS 20
 #define MAX_OBSTACLE_RADIUS 40
 #define OBSTACLE_MASS_SCALE 0.1f // Mass scales with radius-squared
+#define OBSTACLE_POOL_HEADROOM 256 // Pooled slots beyond the initial field
+
+// Broad phase
+#define GRID_CELL_SIZE 64.0f // Target cell edge, adjusted to tile the world
+#define GRID_MAX_CELLS 128   // Per axis; larger worlds reuse cells periodically
+// Below this many asteroids, testing every pair beats building the grid
+#define GRID_MIN_OBSTACLES 64
+
+// Asteroid-vs-asteroid solver
+#define SOLVER_THREADS 0 // 0 = hardware concurrency
+#define SOLVER_PAIR_SLICES 64 // Fixed pair-search partition, thread-independent
+#define SOLVER_PARALLEL_MIN_BATCH 256 // Smaller colors are solved inline
+#define SOLVER_SLICE_RESERVE 64 // Initial pair/partner capacity per slice
+
+// Fragmentation
+#define FRAGMENT_IMPULSE 6000.0f // Impulse that splits an asteroid; 0 = off
+#define FRAGMENT_MIN_RADIUS 10.0f // Smallest piece a split may produce
+#define FRAGMENT_PIECES 3         // Pieces per split (at least 2)
+#define FRAGMENT_SPREAD_SPEED 40.0f // Outward speed added to each piece
+#define FRAGMENT_GAP 1.05f          // Piece spacing beyond touching
+#define FRAGMENT_MAX_PER_TICK 16    // Further splits wait for a later impact
+
+// Determinism
+#define DEFAULT_SEED 1 // Benchmarks and headless runs; the game seeds per run
+#define REPLAY_DEFAULT_PATH "session.dar"
+
+// Snapshots and rewind
+#define SNAPSHOT_INTERVAL_TICKS SIM_TICK_RATE // One checkpoint per second
+#define SNAPSHOT_KEYFRAME_INTERVAL 10 // Whole snapshot every N checkpoints
+#define SNAPSHOT_HISTORY 60u          // Checkpoints kept for rewind
+
+// Batch difficulty analysis
+#define MONTE_CARLO_MAX_SECONDS 600 // Episodes still running are timeouts
+#define MONTE_CARLO_CSV_PATH "montecarlo_oxygen.csv"
+
+// Fixed-timestep simulation
+#define SIM_TICK_RATE 120 // Simulation steps per second, independent of render
+#define SIM_DT (1.0f / SIM_TICK_RATE)
+#define MAX_SUBSTEPS 8 // Longer frames are dropped rather than caught up
+#define SIM_THREAD_SPINS 200   // Yields while awaiting a frame, then sleeps
+#define SIM_THREAD_POLL_US 100 // Idle simulation thread sleep
+#define SIM_THREAD_IDLE_POLL_MS 5 // Sleep while the render side is idle
+
+// Runtime configuration (Config.hpp); the macros above are the defaults
+#ifndef CONFIG_COMPILED_IN
+#define CONFIG_COMPILED_IN 0 // 1 = defaults are constexpr, overrides ignored
+#endif
+#define CONFIG_DEFAULT_PATH "astronaut.cfg" // Loaded at startup if present
+
+// Profiling
+#ifndef ENABLE_PROFILER
+#define ENABLE_PROFILER 0 // Build with -DENABLE_PROFILER=1 (make profile)
+#endif
+#define PROFILER_HISTORY 600 // Frames kept for min/avg/p99
+#define PROFILER_CSV_PATH "profile.csv"
+#define PROFILER_JSON_PATH "profile.json"
+#define PROFILER_SIM_CSV_PATH "profile_sim.csv" // Simulation thread sections
+#define PROFILER_SIM_JSON_PATH "profile_sim.json"
+#define PROFILER_OVERLAY_REFRESH 15 // Frames between overlay text rebuilds
+#define PROFILER_OVERLAY_POS_X 10.0f
+#define PROFILER_OVERLAY_POS_Y 30.0f
+#define PROFILER_TEXT_SIZE 14
 
 // Physics / Collision constants
 #define COLLISION_BOUNCE_FACTOR 0.4f
 #define COLLISION_KICK_FACTOR 0.5f
 #define COLLISION_FRICTION 0.2f // Tangential impulse transfer
 
+// Audio thread
+#define AUDIO_QUEUE_CAPACITY 256 // Commands in flight; power of two
+#define AUDIO_THREAD_POLL_MS 2   // Sleep when the queue is empty
+#define AUDIO_VOICES 16          // Shared one-shot sf::Sound instances
+#define AUDIO_IMPACT_FULL_IMPULSE 4000.0f // Asteroid impact at full volume
+#define AUDIO_FALLOFF_DISTANCE 600.0f // Impacts this far away play at half
+#define AUDIO_PAN_DISTANCE 600.0f     // Offset panned fully to one side
+#define AUDIO_MIN_VOLUME 2.0f         // Quieter impacts are not played
+#define AUDIO_IMPACT_EVENTS 16        // Loudest impacts kept per frame
+#define AUDIO_IMPACT_MIN_IMPULSE 200.0f // Gentler contacts make no sound
+
 // Audio stream identifiers
 #define SOUND_BACKGROUND "assets/sounds/space_background.mp3"
 #define SOUND_BACKGROUND_SCARY "assets/sounds/space_scary.mp3"
@@ -116,6 +198,15 @@
 #define TEXT_RESTART "Press R to Restart"
 #define TEXT_SIZE_LARGE 48
 #define TEXT_SIZE_SMALL 24
+#define TEXT_LOADING "Loading..."
+
+// Idle rendering: launch and end screens block on window events
+#define IDLE_ANIMATION_FPS 20 // Launch screen animation rate when idle
+
+// Startup loading
+#define ASSET_LOADER_THREADS 0 // 0 = hardware concurrency
+#define LOADING_BAR_WIDTH 300.0f
+#define LOADING_BAR_HEIGHT 6.0f
 
 // Audio Thresholds
 #define LOW_OXYGEN_THRESHOLD 50.0f
@@ -134,6 +225,9 @@
 #define TEX_ASTEROID_3 "assets/textures/asteroid3.png"
 #define TEX_ASTEROID_4 "assets/textures/asteroid4.png"
 
+#define ATLAS_MAX_WIDTH 4096 // Safe on modest integrated GPUs
+#define ATLAS_PADDING 2      // Texels between packed images (no bleeding)
+
 #define TEX_WORMHOLE "assets/textures/wormhole.png"
 
 #define TEX_BACKGROUND "assets/textures/space2.jpg"
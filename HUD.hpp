@@ -3,13 +3,24 @@
 
 #include "Astronaut.hpp"
 #include "Constants.h"
+#include "Profiler.hpp"
 #include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <memory>
+#include <string>
 
 class HUD {
   sf::RectangleShape oxygenBar;
   sf::RectangleShape thrustBar;
 
+  // Profiler overlay, rebuilt every PROFILER_OVERLAY_REFRESH frames
+  std::unique_ptr<sf::Text> profilerText;
+  sf::RectangleShape profilerPanel;
+  int profilerFrame = 0;
+
 public:
+  bool showProfiler = false;
+
   HUD() {
     // Oxygen Bar at top
     oxygenBar.setPosition({HUD_OXYGEN_BAR_POS_X, HUD_OXYGEN_BAR_POS_Y});
@@ -19,22 +30,59 @@ public:
     thrustBar.setFillColor(HUD_THRUST_BAR_COLOR);
   }
 
-  void update(const Astronaut &player) {
+  // shipPosition is where the ship is drawn this frame (interpolated)
+  void update(const Astronaut &player, sf::Vector2f shipPosition) {
     // Map 0-100 to 200px width
     oxygenBar.setSize(
         {player.oxygen * HUD_OXYGEN_BAR_WIDTH_SCALE, HUD_OXYGEN_BAR_HEIGHT});
 
     // Position thrust bar slightly below the player
-    thrustBar.setPosition(
-        {player.body->getPosition().x + HUD_THRUST_BAR_OFFSET_X,
-         player.body->getPosition().y + HUD_THRUST_BAR_OFFSET_Y});
+    thrustBar.setPosition({shipPosition.x + HUD_THRUST_BAR_OFFSET_X,
+                           shipPosition.y + HUD_THRUST_BAR_OFFSET_Y});
     thrustBar.setSize({player.thrustCapacity * HUD_THRUST_BAR_WIDTH_SCALE,
                        HUD_THRUST_BAR_HEIGHT});
   }
 
-  void draw(sf::RenderWindow &window) {
-    window.draw(oxygenBar);
-    window.draw(thrustBar);
+  void draw(sf::RenderTarget &target) {
+    target.draw(oxygenBar);
+    target.draw(thrustBar);
+  }
+
+  // min/avg/p99 per profiled section; a no-op unless ENABLE_PROFILER
+  void drawProfiler(sf::RenderWindow &window, const sf::Font &font) {
+#if ENABLE_PROFILER
+    if (!showProfiler)
+      return;
+    if (!profilerText) {
+      profilerText = std::make_unique<sf::Text>(font, "", PROFILER_TEXT_SIZE);
+      profilerText->setFillColor(sf::Color::White);
+      profilerText->setPosition(
+          {PROFILER_OVERLAY_POS_X + 6.0f, PROFILER_OVERLAY_POS_Y + 4.0f});
+      profilerPanel.setFillColor(sf::Color(0, 0, 0, 170));
+      profilerPanel.setPosition(
+          {PROFILER_OVERLAY_POS_X, PROFILER_OVERLAY_POS_Y});
+    }
+
+    if (profilerFrame++ % PROFILER_OVERLAY_REFRESH == 0) {
+      std::string report = "section       min    avg    p99 (ms)\n";
+      char line[64];
+      for (int s = 0; s < PROF_COUNT; s++) {
+        Profiler::Stats st = profiler.stats(s);
+        std::snprintf(line, sizeof(line), "%-11s %6.2f %6.2f %6.2f\n",
+                      profileSectionName(s), st.min, st.avg, st.p99);
+        report += line;
+      }
+      profilerText->setString(report);
+      sf::FloatRect bounds = profilerText->getLocalBounds();
+      profilerPanel.setSize({bounds.size.x + 16.0f, bounds.size.y + 16.0f});
+    }
+
+    window.draw(profilerPanel);
+    window.draw(*profilerText);
+#else
+    (void)window;
+    (void)font;
+#endif
   }
 };
 
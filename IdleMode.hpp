@@ -0,0 +1,147 @@
+#ifndef IDLEMODE_HPP
+#define IDLEMODE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <ostream>
+
+// Power saving while nothing simulates (launch and end screens). Instead
+// of polling and redrawing at the frame limit, the loop blocks in
+// waitEvent until the next animation frame is due, or until an event
+// other than mouse motion arrives. With a zero interval only events wake
+// it. Active, nextEvent() is plain pollEvent().
+class IdlePacer {
+public:
+  void setIdle(bool idle, sf::Time interval) {
+    if (idle && !this->idle)
+      deadline = Clock::now(); // Draw the first idle frame right away
+    this->idle = idle;
+    this->interval = interval;
+  }
+
+  bool isIdle() const { return idle; }
+
+  // Use as the event pump: returns nothing once the next frame is due
+  std::optional<sf::Event> nextEvent(sf::RenderWindow &window) {
+    if (!idle)
+      return window.pollEvent();
+    while (!woken && window.isOpen()) {
+      sf::Time wait = sf::Time::Zero; // Forever
+      if (interval != sf::Time::Zero) {
+        auto remaining = std::chrono::duration_cast<
+            std::chrono::microseconds>(deadline - Clock::now());
+        if (remaining < std::chrono::milliseconds(1))
+          break;
+        wait = sf::microseconds(remaining.count());
+      }
+      if (auto event = window.waitEvent(wait)) {
+        if (!event->is<sf::Event::MouseMoved>())
+          woken = true; // Input, focus, resize and close need a frame
+        return event;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Call after each frame is displayed
+  void frameDone() {
+    woken = false;
+    deadline = Clock::now() + std::chrono::microseconds(
+                                  interval.asMicroseconds());
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+  bool idle = false;
+  bool woken = false;
+  sf::Time interval;
+  Clock::time_point deadline = Clock::now();
+};
+
+// The frozen world drawn once into a texture, so idle frames redraw the
+// scene with one sprite and only the overlay on top is drawn live
+class SceneCache {
+public:
+  bool valid() const { return ready; }
+  void invalidate() { ready = false; }
+
+  // drawScene(target) renders the scene; false if no render texture can
+  // be created, in which case the caller draws the scene itself
+  template <typename DrawScene>
+  bool capture(sf::Vector2u size, const DrawScene &drawScene) {
+    if (unavailable)
+      return false;
+    if (!sprite || texture.getSize() != size) {
+      if (!texture.resize(size)) {
+        unavailable = true;
+        return false;
+      }
+      sprite = std::make_unique<sf::Sprite>(texture.getTexture());
+    }
+    drawScene(texture);
+    texture.display();
+    ready = true;
+    return true;
+  }
+
+  void draw(sf::RenderTarget &target) const { target.draw(*sprite); }
+
+private:
+  sf::RenderTexture texture;
+  std::unique_ptr<sf::Sprite> sprite;
+  bool ready = false;
+  bool unavailable = false;
+};
+
+// Process CPU time (all threads) against wall time, split between frames
+// that simulate and frozen ones (launch and end screens). Printed on exit;
+// run once with --no-idle to compare frozen screens at the frame limit.
+class CpuMeter {
+public:
+  void frame(bool frozen) {
+    Clock::time_point wall = Clock::now();
+    std::clock_t cpu = std::clock();
+    if (started) {
+      Bucket &bucket = buckets[frozen ? 1 : 0];
+      bucket.wall += std::chrono::duration<double>(wall - lastWall).count();
+      bucket.cpu += static_cast<double>(cpu - lastCpu) / CLOCKS_PER_SEC;
+      bucket.frames++;
+    }
+    started = true;
+    lastWall = wall;
+    lastCpu = cpu;
+  }
+
+  // Drops the time since the last frame (e.g. while assets load)
+  void skip() { started = false; }
+
+  void report(std::ostream &out) const {
+    const char *names[2] = {"simulating", "frozen"};
+    out << "CPU use:";
+    for (int i = 0; i < 2; i++) {
+      const Bucket &b = buckets[i];
+      if (b.frames == 0)
+        continue;
+      out << " " << names[i] << " " << 100.0 * b.cpu / b.wall
+          << "% of a core over " << b.frames << " frames ("
+          << 1000.0 * b.wall / b.frames << " ms/frame);";
+    }
+    out << std::endl;
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+  struct Bucket {
+    double wall = 0.0, cpu = 0.0; // Seconds
+    long frames = 0;
+  };
+  Bucket buckets[2];
+  bool started = false;
+  Clock::time_point lastWall;
+  std::clock_t lastCpu = 0;
+};
+
+#endif
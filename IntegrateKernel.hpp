@@ -0,0 +1,194 @@
+#ifndef INTEGRATEKERNEL_HPP
+#define INTEGRATEKERNEL_HPP
+
+// Integrate-and-wrap kernel for packed obstacle columns:
+//   x += vx * dt, wrapped to [0, width] (x < 0 -> width, x > width -> 0)
+//   y += vy * dt, wrapped likewise to [0, height]
+//   a += w * dt,  wrapped to [0, 360)
+// Every variant uses selects instead of branches and a separate multiply and
+// add (never FMA), so all of them produce bit-identical results.
+
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define INTEGRATE_KERNEL_X86 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define INTEGRATE_KERNEL_NEON 1
+#endif
+
+struct IntegrateArgs {
+  float *x;
+  float *y;
+  float *angle;
+  const float *vx;
+  const float *vy;
+  const float *omega;
+  int count;
+  float dt;
+  float width;
+  float height;
+};
+
+using IntegrateFn = void (*)(const IntegrateArgs &);
+
+// Scalar body shared by the fallback and the SIMD tails. Products and sums
+// are separate statements so the compiler cannot contract them into FMA.
+inline void integrateRange(const IntegrateArgs &k, int begin, int end) {
+  for (int i = begin; i < end; i++) {
+    float dx = k.vx[i] * k.dt;
+    float nx = k.x[i] + dx;
+    nx = (nx < 0.f) ? k.width : nx;
+    k.x[i] = (nx > k.width) ? 0.f : nx;
+
+    float dy = k.vy[i] * k.dt;
+    float ny = k.y[i] + dy;
+    ny = (ny < 0.f) ? k.height : ny;
+    k.y[i] = (ny > k.height) ? 0.f : ny;
+
+    float da = k.omega[i] * k.dt;
+    float a = k.angle[i] + da;
+    float below = a - 360.f;
+    a = (a >= 360.f) ? below : a;
+    float above = a + 360.f;
+    k.angle[i] = (a < 0.f) ? above : a;
+  }
+}
+
+inline void integrateScalar(const IntegrateArgs &k) {
+  integrateRange(k, 0, k.count);
+}
+
+#if INTEGRATE_KERNEL_X86
+inline void integrateSSE2(const IntegrateArgs &k) {
+  const __m128 dt = _mm_set1_ps(k.dt);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 width = _mm_set1_ps(k.width);
+  const __m128 height = _mm_set1_ps(k.height);
+  const __m128 turn = _mm_set1_ps(360.f);
+
+  // SSE2 has no blendv: select(m, a, b) = (m & a) | (~m & b)
+  auto select = [](__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  };
+  auto wrap = [&](__m128 p, __m128 limit) {
+    p = select(_mm_cmplt_ps(p, zero), limit, p);
+    return select(_mm_cmpgt_ps(p, limit), zero, p);
+  };
+
+  int i = 0;
+  for (; i + 4 <= k.count; i += 4) {
+    __m128 x = _mm_add_ps(_mm_loadu_ps(k.x + i),
+                          _mm_mul_ps(_mm_loadu_ps(k.vx + i), dt));
+    _mm_storeu_ps(k.x + i, wrap(x, width));
+
+    __m128 y = _mm_add_ps(_mm_loadu_ps(k.y + i),
+                          _mm_mul_ps(_mm_loadu_ps(k.vy + i), dt));
+    _mm_storeu_ps(k.y + i, wrap(y, height));
+
+    __m128 a = _mm_add_ps(_mm_loadu_ps(k.angle + i),
+                          _mm_mul_ps(_mm_loadu_ps(k.omega + i), dt));
+    a = select(_mm_cmpge_ps(a, turn), _mm_sub_ps(a, turn), a);
+    a = select(_mm_cmplt_ps(a, zero), _mm_add_ps(a, turn), a);
+    _mm_storeu_ps(k.angle + i, a);
+  }
+  integrateRange(k, i, k.count);
+}
+
+__attribute__((target("avx2"))) inline void
+integrateAVX2(const IntegrateArgs &k) {
+  const __m256 dt = _mm256_set1_ps(k.dt);
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 width = _mm256_set1_ps(k.width);
+  const __m256 height = _mm256_set1_ps(k.height);
+  const __m256 turn = _mm256_set1_ps(360.f);
+
+  int i = 0;
+  for (; i + 8 <= k.count; i += 8) {
+    __m256 x = _mm256_add_ps(_mm256_loadu_ps(k.x + i),
+                             _mm256_mul_ps(_mm256_loadu_ps(k.vx + i), dt));
+    x = _mm256_blendv_ps(x, width, _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+    x = _mm256_blendv_ps(x, zero, _mm256_cmp_ps(x, width, _CMP_GT_OQ));
+    _mm256_storeu_ps(k.x + i, x);
+
+    __m256 y = _mm256_add_ps(_mm256_loadu_ps(k.y + i),
+                             _mm256_mul_ps(_mm256_loadu_ps(k.vy + i), dt));
+    y = _mm256_blendv_ps(y, height, _mm256_cmp_ps(y, zero, _CMP_LT_OQ));
+    y = _mm256_blendv_ps(y, zero, _mm256_cmp_ps(y, height, _CMP_GT_OQ));
+    _mm256_storeu_ps(k.y + i, y);
+
+    __m256 a = _mm256_add_ps(_mm256_loadu_ps(k.angle + i),
+                             _mm256_mul_ps(_mm256_loadu_ps(k.omega + i), dt));
+    a = _mm256_blendv_ps(a, _mm256_sub_ps(a, turn),
+                         _mm256_cmp_ps(a, turn, _CMP_GE_OQ));
+    a = _mm256_blendv_ps(a, _mm256_add_ps(a, turn),
+                         _mm256_cmp_ps(a, zero, _CMP_LT_OQ));
+    _mm256_storeu_ps(k.angle + i, a);
+  }
+  integrateRange(k, i, k.count);
+}
+#endif
+
+#if INTEGRATE_KERNEL_NEON
+inline void integrateNEON(const IntegrateArgs &k) {
+  const float32x4_t dt = vdupq_n_f32(k.dt);
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  const float32x4_t width = vdupq_n_f32(k.width);
+  const float32x4_t height = vdupq_n_f32(k.height);
+  const float32x4_t turn = vdupq_n_f32(360.f);
+
+  int i = 0;
+  for (; i + 4 <= k.count; i += 4) {
+    float32x4_t x =
+        vaddq_f32(vld1q_f32(k.x + i), vmulq_f32(vld1q_f32(k.vx + i), dt));
+    x = vbslq_f32(vcltq_f32(x, zero), width, x);
+    x = vbslq_f32(vcgtq_f32(x, width), zero, x);
+    vst1q_f32(k.x + i, x);
+
+    float32x4_t y =
+        vaddq_f32(vld1q_f32(k.y + i), vmulq_f32(vld1q_f32(k.vy + i), dt));
+    y = vbslq_f32(vcltq_f32(y, zero), height, y);
+    y = vbslq_f32(vcgtq_f32(y, height), zero, y);
+    vst1q_f32(k.y + i, y);
+
+    float32x4_t a = vaddq_f32(vld1q_f32(k.angle + i),
+                              vmulq_f32(vld1q_f32(k.omega + i), dt));
+    a = vbslq_f32(vcgeq_f32(a, turn), vsubq_f32(a, turn), a);
+    a = vbslq_f32(vcltq_f32(a, zero), vaddq_f32(a, turn), a);
+    vst1q_f32(k.angle + i, a);
+  }
+  integrateRange(k, i, k.count);
+}
+#endif
+
+// Widest variant the running CPU supports, resolved once
+inline IntegrateFn selectIntegrateKernel() {
+#if INTEGRATE_KERNEL_X86
+  if (__builtin_cpu_supports("avx2"))
+    return integrateAVX2;
+  return integrateSSE2;
+#elif INTEGRATE_KERNEL_NEON
+  return integrateNEON;
+#else
+  return integrateScalar;
+#endif
+}
+
+inline const char *integrateKernelName(IntegrateFn fn) {
+#if INTEGRATE_KERNEL_X86
+  if (fn == integrateAVX2)
+    return "avx2";
+  if (fn == integrateSSE2)
+    return "sse2";
+#elif INTEGRATE_KERNEL_NEON
+  if (fn == integrateNEON)
+    return "neon";
+#endif
+  return "scalar";
+}
+
+inline void integrateObstacles(const IntegrateArgs &args) {
+  static const IntegrateFn fn = selectIntegrateKernel();
+  fn(args);
+}
+
+#endif
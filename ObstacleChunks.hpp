@@ -0,0 +1,184 @@
+#ifndef OBSTACLECHUNKS_HPP
+#define OBSTACLECHUNKS_HPP
+
+#include "Config.hpp"
+#include "Constants.h"
+#include "ObstacleField.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+// An asteroid parked outside the active region. It flies in a straight line
+// until woken, so its state is stored as of `stamp` and advanced
+// analytically on demand.
+struct DormantObstacle {
+  float x, y;
+  float vx, vy;
+  float angle, omega;
+  float radius;
+  float invMass;
+  int textureIndex;
+  int stamp; // World tick the state above belongs to (no padding: snapshots
+             // copy this struct byte for byte)
+};
+
+// Large-world streaming for ObstacleField. The world is tiled into chunks;
+// only asteroids in the (2 * CHUNK_ACTIVE_RADIUS + 1)^2 chunks around the
+// ship live in the field and are fully simulated (integration, collisions,
+// solver, grid). Everything else is parked per chunk. Parked chunks are
+// refiled round-robin so each is revisited about every CHUNK_SWEEP_SECONDS:
+// its bodies are advanced to the current tick and moved to the chunk they
+// drifted into, or woken if that chunk is active. Per-tick cost therefore
+// follows the active region plus a small sweep budget, not the world size.
+// Every decision depends only on tick counts and state, so streaming is as
+// deterministic as the rest of the simulation.
+class ObstacleChunks {
+public:
+  int cols;
+  int rows;
+  float chunkWidth;
+  float chunkHeight;
+  bool enabled; // Off when the active window already covers the world
+
+  std::map<int, std::vector<DormantObstacle>> dormant; // By chunk index
+  int centerChunk = -1; // Chunk the active window was last centered on
+  int sweepCursor = 0;  // Next dormant chunk index to refile
+
+  ObstacleChunks() {
+    // Chunks tile the world exactly, like SpatialGrid cells
+    cols = std::max(1, static_cast<int>(tuning.worldWidth / CHUNK_SIZE));
+    rows = std::max(1, static_cast<int>(tuning.worldHeight / CHUNK_SIZE));
+    chunkWidth = static_cast<float>(tuning.worldWidth) / cols;
+    chunkHeight = static_cast<float>(tuning.worldHeight) / rows;
+    const int span = 2 * CHUNK_ACTIVE_RADIUS + 1;
+    enabled = cols > span || rows > span;
+  }
+
+  int chunkOf(float x, float y) const {
+    int c = std::clamp(static_cast<int>(x / chunkWidth), 0, cols - 1);
+    int r = std::clamp(static_cast<int>(y / chunkHeight), 0, rows - 1);
+    return r * cols + c;
+  }
+
+  // Within CHUNK_ACTIVE_RADIUS of the center chunk, across the seams
+  bool isActive(int chunk) const {
+    auto near = [](int a, int b, int period) {
+      int d = std::abs(a - b);
+      return std::min(d, period - d) <= CHUNK_ACTIVE_RADIUS;
+    };
+    return near(chunk % cols, centerChunk % cols, cols) &&
+           near(chunk / cols, centerChunk / cols, rows);
+  }
+
+  size_t dormantCount() const {
+    size_t total = 0;
+    for (const auto &entry : dormant)
+      total += entry.second.size();
+    return total;
+  }
+
+  // Park the whole field, then wake the region around focus. Used after
+  // spawning.
+  void reset(ObstacleField &field, sf::Vector2f focus, long now) {
+    dormant.clear();
+    sweepCursor = 0;
+    for (int i = 0; i < field.size(); i++)
+      park(field, i, now);
+    field.clear();
+    centerChunk = -1;
+    update(field, focus, now);
+  }
+
+  // Once per tick, before the tick's previous state is saved
+  void update(ObstacleField &field, sf::Vector2f focus, long now) {
+    int focusChunk = chunkOf(focus.x, focus.y);
+    bool moved = focusChunk != centerChunk;
+    centerChunk = focusChunk;
+
+    // Bodies that left the active window (or the window left them)
+    field.removeIf([&](int i) {
+      if (isActive(chunkOf(field.x[i], field.y[i])))
+        return false;
+      park(field, i, now);
+      return true;
+    });
+
+    // Newly active chunks, in fixed row-major order around the center
+    if (moved) {
+      std::vector<int> activeCols = window(centerChunk % cols, cols);
+      std::vector<int> activeRows = window(centerChunk / cols, rows);
+      for (int r : activeRows)
+        for (int c : activeCols)
+          refile(field, r * cols + c, now);
+    }
+
+    // Lazy sweep of the far field
+    if (dormant.empty())
+      return;
+    size_t budget =
+        dormant.size() / (CHUNK_SWEEP_SECONDS * SIM_TICK_RATE) + 1;
+    for (size_t k = 0; k < budget && !dormant.empty(); k++) {
+      auto it = dormant.lower_bound(sweepCursor);
+      if (it == dormant.end())
+        it = dormant.begin();
+      sweepCursor = it->first + 1;
+      refile(field, it->first, now);
+    }
+  }
+
+private:
+  // Active indices along one axis, each once even when the window wraps
+  // onto itself
+  static std::vector<int> window(int center, int period) {
+    std::vector<int> indices;
+    if (2 * CHUNK_ACTIVE_RADIUS + 1 >= period) {
+      for (int i = 0; i < period; i++)
+        indices.push_back(i);
+      return indices;
+    }
+    for (int d = -CHUNK_ACTIVE_RADIUS; d <= CHUNK_ACTIVE_RADIUS; d++)
+      indices.push_back(((center + d) % period + period) % period);
+    return indices;
+  }
+
+  void park(const ObstacleField &field, int i, long now) {
+    dormant[chunkOf(field.x[i], field.y[i])].push_back(
+        {field.x[i], field.y[i], field.vx[i], field.vy[i], field.angle[i],
+         field.omega[i], field.radius[i], field.invMass[i],
+         field.textureIndex[i], static_cast<int>(now)});
+  }
+
+  // Advance every body parked in chunk to now, then wake it into the field
+  // or park it again where it has drifted to
+  void refile(ObstacleField &field, int chunk, long now) {
+    auto node = dormant.extract(chunk);
+    if (node.empty())
+      return;
+    for (DormantObstacle &body : node.mapped()) {
+      float t = static_cast<float>(now - body.stamp) * SIM_DT;
+      body.x = wrapCoordinate(body.x + body.vx * t, tuning.worldWidth);
+      body.y = wrapCoordinate(body.y + body.vy * t, tuning.worldHeight);
+      body.angle = wrapCoordinate(body.angle + body.omega * t, 360.0f);
+      body.stamp = static_cast<int>(now);
+
+      int home = chunkOf(body.x, body.y);
+      if (isActive(home)) {
+        int i = field.add(body.textureIndex, {body.x, body.y},
+                          {body.vx, body.vy}, body.radius, body.omega);
+        field.angle[i] = body.angle;
+        field.invMass[i] = body.invMass;
+      } else {
+        dormant[home].push_back(body);
+      }
+    }
+  }
+
+  static float wrapCoordinate(float value, float period) {
+    value = std::fmod(value, period);
+    return value < 0.0f ? value + period : value;
+  }
+};
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef OBSTACLEFIELD_HPP
+#define OBSTACLEFIELD_HPP
+
+#include "Config.hpp"
+#include "Constants.h"
+#include "IntegrateKernel.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// Stable reference to a pooled asteroid. Dense indices shift when bodies are
+// removed; a handle keeps naming the same body until it is removed, parked or
+// the field is cleared, after which it resolves to -1.
+struct ObstacleHandle {
+  int slot = -1;
+  int generation = 0;
+};
+
+// Structure-of-arrays storage for every asteroid. Physics walks the
+// contiguous arrays directly; sprites are only produced by WorldRenderer at
+// draw time. Angles are in degrees, wrapped to [0, 360).
+//
+// The columns are a fixed-capacity pool: reserve() sizes every column and
+// the handle tables once, and add/remove then recycle storage and handle
+// slots (LIFO free list) without touching the allocator. Running past the
+// capacity doubles it and is counted in stats.growths, so a steady state
+// with zero growths makes no obstacle allocations at all.
+class ObstacleField {
+public:
+  std::vector<float> x, y;
+  std::vector<float> vx, vy;
+  std::vector<float> angle, omega; // deg, deg/s
+  std::vector<float> radius;
+  std::vector<float> invMass;      // Mass scales with area (radius squared)
+  std::vector<int> textureIndex;   // Asteroid variant picked by the renderer
+  std::vector<int> slotOf;         // Handle slot of each body
+
+  struct Stats {
+    long spawned = 0;
+    long removed = 0;
+    long growths = 0; // Adds that had to enlarge the pool
+    int highWater = 0; // Most bodies alive at once
+  };
+  Stats stats;
+
+  int size() const { return static_cast<int>(x.size()); }
+  int capacity() const { return static_cast<int>(x.capacity()); }
+
+  void reserve(int count) {
+    for (auto *column : floatColumns())
+      column->reserve(count);
+    for (auto *column : {&textureIndex, &slotOf, &indexOf, &generation,
+                         &freeSlots})
+      column->reserve(count);
+  }
+
+  // Removes every body and invalidates all handles; capacity is kept
+  void clear() {
+    stats.removed += size();
+    for (auto *column : floatColumns())
+      column->clear();
+    textureIndex.clear();
+    slotOf.clear();
+    freeSlots.clear();
+    for (int slot = static_cast<int>(indexOf.size()) - 1; slot >= 0; slot--) {
+      if (indexOf[slot] >= 0)
+        generation[slot]++;
+      indexOf[slot] = -1;
+      freeSlots.push_back(slot);
+    }
+  }
+
+  int add(int texIndex, sf::Vector2f pos, sf::Vector2f vel, float r,
+          float spin) {
+    if (size() == capacity()) {
+      reserve(std::max(2 * capacity(), 16));
+      stats.growths++;
+    }
+    int slot;
+    if (freeSlots.empty()) {
+      slot = static_cast<int>(indexOf.size());
+      indexOf.push_back(-1);
+      generation.push_back(0);
+    } else {
+      slot = freeSlots.back();
+      freeSlots.pop_back();
+    }
+    indexOf[slot] = size();
+
+    x.push_back(pos.x);
+    y.push_back(pos.y);
+    vx.push_back(vel.x);
+    vy.push_back(vel.y);
+    angle.push_back(0.f);
+    omega.push_back(spin);
+    radius.push_back(r);
+    invMass.push_back(1.0f / (r * r * tuning.obstacleMassScale));
+    textureIndex.push_back(texIndex);
+    slotOf.push_back(slot);
+
+    stats.spawned++;
+    stats.highWater = std::max(stats.highWater, size());
+    return size() - 1;
+  }
+
+  ObstacleHandle handle(int i) const {
+    return {slotOf[i], generation[slotOf[i]]};
+  }
+
+  // Dense index of a handle's body, or -1 once it is gone
+  int index(ObstacleHandle h) const {
+    if (h.slot < 0 || h.slot >= static_cast<int>(indexOf.size()) ||
+        generation[h.slot] != h.generation)
+      return -1;
+    return indexOf[h.slot];
+  }
+
+  // O(1) removal: the last body moves into the hole, so only its index
+  // changes. Returns false for a stale handle.
+  bool remove(ObstacleHandle h) {
+    int i = index(h);
+    if (i < 0)
+      return false;
+    int last = size() - 1;
+    if (i != last) {
+      for (auto *column : floatColumns())
+        (*column)[i] = (*column)[last];
+      textureIndex[i] = textureIndex[last];
+      slotOf[i] = slotOf[last];
+      indexOf[slotOf[i]] = i;
+    }
+    release(h.slot);
+    for (auto *column : floatColumns())
+      column->pop_back();
+    textureIndex.pop_back();
+    slotOf.pop_back();
+    return true;
+  }
+
+  // Drops every body for which remove(i) is true; survivors keep their
+  // relative order so the solver's pair order stays canonical
+  template <typename Pred> void removeIf(Pred &&remove) {
+    int kept = 0;
+    for (int i = 0; i < size(); i++) {
+      if (remove(i)) {
+        release(slotOf[i]);
+        continue;
+      }
+      for (auto *column : floatColumns())
+        (*column)[kept] = (*column)[i];
+      textureIndex[kept] = textureIndex[i];
+      slotOf[kept] = slotOf[i];
+      indexOf[slotOf[kept]] = kept;
+      kept++;
+    }
+    for (auto *column : floatColumns())
+      column->resize(kept);
+    textureIndex.resize(kept);
+    slotOf.resize(kept);
+  }
+
+  // Replaces the contents with a copy of source's bodies (handles are not
+  // carried over), reusing this pool's storage
+  void assign(const ObstacleField &source) {
+    clear();
+    for (int i = 0; i < source.size(); i++) {
+      int k = add(source.textureIndex[i], source.position(i),
+                  source.velocity(i), source.radius[i], source.omega[i]);
+      angle[k] = source.angle[i];
+      invMass[k] = source.invMass[i];
+    }
+  }
+
+  sf::Vector2f position(int i) const { return {x[i], y[i]}; }
+  sf::Vector2f velocity(int i) const { return {vx[i], vy[i]}; }
+  float mass(int i) const { return 1.0f / invMass[i]; }
+
+  // Integrate every body with periodic boundaries using the widest SIMD
+  // kernel the CPU supports (see IntegrateKernel.hpp)
+  void integrate(float dt) {
+    integrateObstacles({x.data(), y.data(), angle.data(), vx.data(), vy.data(),
+                        omega.data(), size(), dt,
+                        static_cast<float>(tuning.worldWidth),
+                        static_cast<float>(tuning.worldHeight)});
+  }
+
+private:
+  std::vector<int> indexOf;    // Dense index per slot, -1 while free
+  std::vector<int> generation; // Bumped whenever a slot is freed
+  std::vector<int> freeSlots;  // Reused last-in, first-out
+
+  std::array<std::vector<float> *, 8> floatColumns() {
+    return {&x, &y, &vx, &vy, &angle, &omega, &radius, &invMass};
+  }
+
+  void release(int slot) {
+    indexOf[slot] = -1;
+    generation[slot]++;
+    freeSlots.push_back(slot);
+    stats.removed++;
+  }
+};
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef OBSTACLEFRAGMENTER_HPP
+#define OBSTACLEFRAGMENTER_HPP
+
+#include "Collision.hpp"
+#include "Config.hpp"
+#include "Constants.h"
+#include "ObstacleField.hpp"
+#include "ObstacleSolver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Breaks asteroids apart on hard impacts. Each tick records the peak
+// impulse every body received (ship hits and solver pairs); bodies at or
+// above tuning.fragmentImpulse split into FRAGMENT_PIECES equal pieces
+// that conserve mass and linear momentum. Pieces smaller than the smallest
+// spawned asteroid count as debris, and touching debris merges back into
+// one body, so chain reactions settle instead of grinding everything to
+// dust.
+//
+// Cost stays flat under chain reactions: at most FRAGMENT_MAX_PER_TICK
+// splits run per tick (lowest index first), and pieces come from the
+// obstacle pool's spare capacity. A full pool stops splitting rather than
+// growing, so the body count is bounded by the capacity World reserved.
+class ObstacleFragmenter {
+public:
+  std::vector<float> impacts; // Peak impulse per body this tick
+  std::vector<std::uint8_t> removing;
+
+  // Before the tick's collisions run
+  void beginStep(int bodyCount) { impacts.assign(bodyCount, 0.0f); }
+
+  void recordImpact(int i, float impulse) {
+    impacts[i] = std::max(impacts[i], impulse);
+  }
+
+  // Splits and merges after the solver. solver is null when asteroid pairs
+  // were not resolved this tick. The render history (prev*) is compacted
+  // alongside the field so interpolation stays aligned; new pieces are
+  // appended and have none. Returns the number of splits.
+  int apply(ObstacleField &field, const ObstacleSolver *solver,
+            std::vector<float> &prevX, std::vector<float> &prevY,
+            std::vector<float> &prevAngle) {
+    const int n = field.size();
+    if (solver) {
+      for (size_t p = 0; p < solver->pairs.size(); p++) {
+        if (solver->pairImpulse[p] <= 0.0f)
+          continue;
+        recordImpact(solver->pairs[p].first, solver->pairImpulse[p]);
+        recordImpact(solver->pairs[p].second, solver->pairImpulse[p]);
+      }
+    }
+
+    removing.assign(n, 0);
+    int removed = 0;
+    int splits = 0;
+    const float shrink = 1.0f / std::sqrt(static_cast<float>(FRAGMENT_PIECES));
+    for (int i = 0; i < n && splits < FRAGMENT_MAX_PER_TICK; i++) {
+      if (impacts[i] < tuning.fragmentImpulse ||
+          field.radius[i] * shrink < tuning.fragmentMinRadius)
+        continue;
+      // Parents are only compacted away at the end, so count them
+      if (field.size() + FRAGMENT_PIECES > field.capacity())
+        break;
+      split(field, i, field.radius[i] * shrink);
+      removing[i] = 1;
+      removed++;
+      splits++;
+    }
+
+    if (solver) {
+      for (size_t p = 0; p < solver->pairs.size(); p++) {
+        int a = solver->pairs[p].first;
+        int b = solver->pairs[p].second;
+        if (!solver->pairHit[p] || removing[a] || removing[b] ||
+            !isDebris(field, a) || !isDebris(field, b))
+          continue;
+        merge(field, a, b);
+        removing[b] = 1;
+        removed++;
+      }
+    }
+
+    if (removed > 0) {
+      field.removeIf([&](int i) { return i < n && removing[i]; });
+      for (auto *history : {&prevX, &prevY, &prevAngle})
+        compact(*history);
+    }
+    return splits;
+  }
+
+private:
+  static bool isDebris(const ObstacleField &field, int i) {
+    return field.radius[i] < tuning.minObstacleRadius;
+  }
+
+  // Pieces sit evenly around the parent, just clear of each other, and
+  // fly apart at FRAGMENT_SPREAD_SPEED. The radial kicks cancel, so total
+  // momentum is the parent's.
+  void split(ObstacleField &field, int i, float pieceRadius) {
+    const float pi = 3.14159f;
+    sf::Vector2f center = field.position(i);
+    sf::Vector2f velocity = field.velocity(i);
+    float distance =
+        pieceRadius / std::sin(pi / FRAGMENT_PIECES) * FRAGMENT_GAP;
+    for (int m = 0; m < FRAGMENT_PIECES; m++) {
+      float rad = (field.angle[i] + 360.0f * m / FRAGMENT_PIECES) *
+                  (pi / 180.0f);
+      sf::Vector2f dir(std::cos(rad), std::sin(rad));
+      sf::Vector2f pos = center + dir * distance;
+      pos = {wrap(pos.x, tuning.worldWidth), wrap(pos.y, tuning.worldHeight)};
+      int k = field.add(field.textureIndex[i], pos,
+                        velocity + dir * FRAGMENT_SPREAD_SPEED, pieceRadius,
+                        field.omega[i]);
+      field.angle[k] = field.angle[i];
+      // Exact mass split rather than recomputed from the rounded radius
+      field.invMass[k] = field.invMass[i] * FRAGMENT_PIECES;
+    }
+  }
+
+  // b joins a: mass and momentum add, the center moves to the barycenter
+  // and the area (so mass) is preserved
+  static void merge(ObstacleField &field, int a, int b) {
+    float massA = field.mass(a);
+    float massB = field.mass(b);
+    float share = massB / (massA + massB);
+    float dx = wrapDelta(field.x[b] - field.x[a], tuning.worldWidth);
+    float dy = wrapDelta(field.y[b] - field.y[a], tuning.worldHeight);
+    field.x[a] = wrap(field.x[a] + dx * share, tuning.worldWidth);
+    field.y[a] = wrap(field.y[a] + dy * share, tuning.worldHeight);
+    field.vx[a] += (field.vx[b] - field.vx[a]) * share;
+    field.vy[a] += (field.vy[b] - field.vy[a]) * share;
+    field.omega[a] += (field.omega[b] - field.omega[a]) * share;
+    field.radius[a] = std::hypot(field.radius[a], field.radius[b]);
+    field.invMass[a] = 1.0f / (massA + massB);
+  }
+
+  void compact(std::vector<float> &column) const {
+    size_t kept = 0;
+    for (size_t i = 0; i < column.size(); i++) {
+      if (i < removing.size() && removing[i])
+        continue;
+      column[kept++] = column[i];
+    }
+    column.resize(kept);
+  }
+
+  static float wrap(float value, float period) {
+    if (value < 0.0f)
+      return value + period;
+    if (value >= period)
+      return value - period;
+    return value;
+  }
+};
+
+#endif
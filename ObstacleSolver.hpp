@@ -0,0 +1,164 @@
+#ifndef OBSTACLESOLVER_HPP
+#define OBSTACLESOLVER_HPP
+
+#include "Collision.hpp"
+#include "Config.hpp"
+#include "Constants.h"
+#include "ObstacleField.hpp"
+#include "SpatialGrid.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Asteroid-vs-asteroid contact solver. Each tick it:
+//   1. builds the overlapping pair list in canonical (i < j) order, split
+//      into a fixed number of slices so the order never depends on threads,
+//   2. greedily edge-colors the pairs so no body appears twice in a color,
+//   3. resolves colors in order, fanning each color out over the pool.
+// Pairs within a color touch disjoint bodies, so results are bit-identical
+// for any thread count.
+class ObstacleSolver {
+public:
+  std::vector<std::pair<int, int>> pairs;
+  std::vector<std::vector<std::pair<int, int>>> slicePairs;
+  std::vector<std::vector<int>> slicePartners; // Per-slice query scratch
+
+  std::vector<std::uint64_t> bodyColors; // Bitmask of colors used per body
+  std::vector<int> batchStart;           // CSR offsets per color
+  std::vector<int> batchPairs;           // Pair indices grouped by color
+  std::vector<int> batchCursor;
+  std::vector<int> pairColor;
+  std::vector<std::uint8_t> pairHit;
+  std::vector<float> pairImpulse; // Linear impulse exchanged per pair
+
+  ThreadPool pool;
+
+  explicit ObstacleSolver(int threadCount = tuning.solverThreads)
+      : slicePairs(SOLVER_PAIR_SLICES), slicePartners(SOLVER_PAIR_SLICES),
+        pool(threadCount) {
+    // Headroom so ordinary ticks do not grow the scratch one slice at a time
+    for (int s = 0; s < SOLVER_PAIR_SLICES; s++) {
+      slicePairs[s].reserve(SOLVER_SLICE_RESERVE);
+      slicePartners[s].reserve(SOLVER_SLICE_RESERVE);
+    }
+  }
+
+  // Resolve all overlapping obstacles; grid may be null for the O(n^2)
+  // reference sweep. Returns the number of pairs that were in contact.
+  int solve(ObstacleField &field, const SpatialGrid *grid) {
+    findPairs(field, grid);
+    colorPairs(field.size());
+
+    pairHit.assign(pairs.size(), 0);
+    pairImpulse.assign(pairs.size(), 0.0f);
+    auto resolveRange = [&](int begin, int end) {
+      for (int k = begin; k < end; k++) {
+        int p = batchPairs[k];
+        int a = pairs[p].first;
+        float vx = field.vx[a];
+        float vy = field.vy[a];
+        pairHit[p] = resolveObstaclePair(field, a, pairs[p].second);
+        // Both bodies receive the same impulse: mass times velocity change
+        pairImpulse[p] = std::hypot(field.vx[a] - vx, field.vy[a] - vy) /
+                         field.invMass[a];
+      }
+    };
+
+    const int colors = static_cast<int>(batchStart.size()) - 1;
+    for (int c = 0; c < colors; c++) {
+      int begin = batchStart[c];
+      int size = batchStart[c + 1] - begin;
+      // Last color collects overflow pairs that share bodies: run serially
+      if (c == colors - 1 || size < SOLVER_PARALLEL_MIN_BATCH) {
+        resolveRange(begin, begin + size);
+      } else {
+        pool.parallelFor(size, [&](int b, int e) {
+          resolveRange(begin + b, begin + e);
+        });
+      }
+    }
+
+    int contacts = 0;
+    for (std::uint8_t hit : pairHit)
+      contacts += hit;
+    return contacts;
+  }
+
+  void findPairs(const ObstacleField &field, const SpatialGrid *grid) {
+    const int n = field.size();
+    const int slices = static_cast<int>(slicePairs.size());
+
+    pool.parallelFor(slices, [&](int sliceBegin, int sliceEnd) {
+      for (int s = sliceBegin; s < sliceEnd; s++) {
+        auto &out = slicePairs[s];
+        auto &partners = slicePartners[s];
+        out.clear();
+        int begin = static_cast<int>(static_cast<long long>(n) * s / slices);
+        int end =
+            static_cast<int>(static_cast<long long>(n) * (s + 1) / slices);
+        for (int i = begin; i < end; i++) {
+          sf::Vector2f pos = field.position(i);
+          float radius = field.radius[i];
+          partners.clear();
+          auto consider = [&](int j) {
+            if (j <= i)
+              return;
+            sf::Vector2f diff = wrapOffset(pos - field.position(j));
+            float minDistance = radius + field.radius[j];
+            if (diff.x * diff.x + diff.y * diff.y < minDistance * minDistance)
+              partners.push_back(j);
+          };
+          if (grid) {
+            grid->forEachInRange(pos, radius + grid->maxRadius, consider);
+            std::sort(partners.begin(), partners.end());
+          } else {
+            for (int j = i + 1; j < n; j++)
+              consider(j);
+          }
+          for (int j : partners)
+            out.emplace_back(i, j);
+        }
+      }
+    });
+
+    pairs.clear();
+    for (const auto &slice : slicePairs)
+      pairs.insert(pairs.end(), slice.begin(), slice.end());
+  }
+
+  // Greedy edge coloring in canonical pair order. Colors beyond the 64-bit
+  // mask spill into one final batch that is solved serially.
+  void colorPairs(int bodyCount) {
+    const int maxColors = 64;
+    bodyColors.assign(bodyCount, 0);
+    pairColor.resize(pairs.size());
+    batchStart.assign(maxColors + 2, 0);
+
+    for (size_t p = 0; p < pairs.size(); p++) {
+      std::uint64_t used =
+          bodyColors[pairs[p].first] | bodyColors[pairs[p].second];
+      int color = maxColors;
+      if (used != ~std::uint64_t(0)) {
+        color = __builtin_ctzll(~used);
+        std::uint64_t bit = std::uint64_t(1) << color;
+        bodyColors[pairs[p].first] |= bit;
+        bodyColors[pairs[p].second] |= bit;
+      }
+      pairColor[p] = color;
+      batchStart[color + 1]++;
+    }
+
+    for (size_t c = 1; c < batchStart.size(); c++)
+      batchStart[c] += batchStart[c - 1];
+
+    batchCursor.assign(batchStart.begin(), batchStart.end() - 1);
+    batchPairs.resize(pairs.size());
+    for (size_t p = 0; p < pairs.size(); p++)
+      batchPairs[batchCursor[pairColor[p]]++] = static_cast<int>(p);
+  }
+};
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "Constants.h"
+
+// Frame-section timers. Build with -DENABLE_PROFILER=1 (make profile) to
+// turn them on; otherwise PROFILE_SCOPE expands to nothing and the
+// Profiler methods are empty.
+enum ProfileSection {
+  PROF_EVENTS,
+  PROF_SIMULATION, // Render thread: inline update or wait for the sim thread
+  PROF_PLAYER,
+  PROF_OBSTACLES,
+  PROF_COLLISIONS,
+  PROF_SOLVER,
+  PROF_FRAGMENTS,
+  PROF_HUD,
+  PROF_AUDIO,
+  PROF_DRAW_WORLD,
+  PROF_DRAW_HUD,
+  PROF_DRAW_TEXT,
+  PROF_DISPLAY,
+  PROF_FRAME, // Wall time between endFrame() calls
+  PROF_COUNT
+};
+
+inline const char *profileSectionName(int section) {
+  static const char *names[PROF_COUNT] = {
+      "events",     "simulation", "player",    "obstacles",
+      "collisions", "solver",     "fragments", "hud",
+      "audio",      "draw_world", "draw_hud",  "draw_text",
+      "display",    "frame_total"};
+  return names[section];
+}
+
+#if ENABLE_PROFILER
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+// Keeps the last PROFILER_HISTORY frames of per-section times (ms) in a
+// ring buffer. Each thread records into its own instance; the render
+// thread merges in the simulation thread's frames so the overlay and dumps
+// show every section.
+class Profiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Stats {
+    float min = 0.0f;
+    float avg = 0.0f;
+    float p99 = 0.0f;
+  };
+
+  float history[PROFILER_HISTORY][PROF_COUNT] = {};
+  float current[PROF_COUNT] = {};
+  int frames = 0; // Total frames recorded
+  Clock::time_point frameStart = Clock::now();
+
+  void add(int section, Clock::duration elapsed) {
+    current[section] +=
+        std::chrono::duration<float, std::milli>(elapsed).count();
+  }
+
+  // Sections entered several times in a frame are summed
+  void endFrame() {
+    Clock::time_point now = Clock::now();
+    current[PROF_FRAME] =
+        std::chrono::duration<float, std::milli>(now - frameStart).count();
+    frameStart = now;
+
+    float *row = history[frames % PROFILER_HISTORY];
+    std::copy(current, current + PROF_COUNT, row);
+    std::fill(current, current + PROF_COUNT, 0.0f);
+    frames++;
+  }
+
+  // Hands the frame in progress to another thread's merge()
+  void copyFrame(float *sections) const {
+    std::copy(current, current + PROF_COUNT, sections);
+  }
+
+  // Adds another thread's frame (e.g. the simulation thread's world
+  // sections) to this one; frame_total stays this thread's own
+  void merge(const float *sections) {
+    for (int s = 0; s < PROF_COUNT; s++)
+      if (s != PROF_FRAME)
+        current[s] += sections[s];
+  }
+
+  int recorded() const { return std::min(frames, PROFILER_HISTORY); }
+
+  Stats stats(int section) const {
+    Stats s;
+    int count = recorded();
+    if (count == 0)
+      return s;
+    std::vector<float> values(count);
+    for (int i = 0; i < count; i++)
+      values[i] = history[i][section];
+    std::sort(values.begin(), values.end());
+    float sum = 0.0f;
+    for (float v : values)
+      sum += v;
+    s.min = values.front();
+    s.avg = sum / count;
+    s.p99 = values[std::min(count - 1, (count * 99) / 100)];
+    return s;
+  }
+
+  // One row per recorded frame, oldest first
+  void writeCsv(const char *path) const {
+    std::ofstream out(path);
+    out << "frame";
+    for (int s = 0; s < PROF_COUNT; s++)
+      out << "," << profileSectionName(s);
+    out << "\n";
+    int count = recorded();
+    for (int i = 0; i < count; i++) {
+      int frame = frames - count + i;
+      const float *row = history[frame % PROFILER_HISTORY];
+      out << frame;
+      for (int s = 0; s < PROF_COUNT; s++)
+        out << "," << row[s];
+      out << "\n";
+    }
+  }
+
+  // Summary over the recorded window
+  void writeJson(const char *path) const {
+    std::ofstream out(path);
+    out << "{\n  \"frames\": " << recorded() << ",\n  \"sections\": {\n";
+    for (int s = 0; s < PROF_COUNT; s++) {
+      Stats st = stats(s);
+      out << "    \"" << profileSectionName(s) << "\": {\"min\": " << st.min
+          << ", \"avg\": " << st.avg << ", \"p99\": " << st.p99 << "}"
+          << (s + 1 < PROF_COUNT ? ",\n" : "\n");
+    }
+    out << "  }\n}\n";
+  }
+};
+
+// Adds the lifetime of the scope to a section
+class ProfileScope {
+public:
+  explicit ProfileScope(int section)
+      : section(section), start(Profiler::Clock::now()) {}
+  ~ProfileScope();
+
+private:
+  int section;
+  Profiler::Clock::time_point start;
+};
+
+inline thread_local Profiler profiler;
+
+inline ProfileScope::~ProfileScope() {
+  profiler.add(section, Profiler::Clock::now() - start);
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(section)                                                 \
+  ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(section)
+
+#else
+
+// Disabled build: same interface, no work
+class Profiler {
+public:
+  struct Stats {
+    float min = 0.0f;
+    float avg = 0.0f;
+    float p99 = 0.0f;
+  };
+  void endFrame() {}
+  void copyFrame(float *) const {}
+  void merge(const float *) {}
+  int recorded() const { return 0; }
+  Stats stats(int) const { return {}; }
+  void writeCsv(const char *) const {}
+  void writeJson(const char *) const {}
+};
+
+inline Profiler profiler;
+
+#define PROFILE_SCOPE(section)
+
+#endif
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef RENDERSNAPSHOT_HPP
+#define RENDERSNAPSHOT_HPP
+
+#include "Astronaut.hpp"
+#include "Constants.h"
+#include "Goal.hpp"
+#include "Profiler.hpp"
+#include "World.hpp"
+#include <algorithm>
+#include <vector>
+
+// Everything needed to draw and voice one frame, copied out of a World
+// right after its update. Poses are already blended to the frame's
+// interpolation alpha, so the render thread reads no simulation state and
+// drawing can overlap with the next update. Columns keep their capacity
+// between captures, so a steady field copies without allocating.
+struct RenderSnapshot {
+  long tickCount = 0;
+  int gameState = GAME_STATE_START;
+
+  // Copies carry the HUD values and ship texture state; position, angle
+  // and rotation hold the blended pose
+  Astronaut player;
+  Goal wormhole;
+
+  // Asteroids, blended
+  std::vector<float> x, y, angle;
+  std::vector<float> radius;
+  std::vector<int> textureIndex;
+
+  // Results of the frame's update, for audio
+  bool simulated = false; // The world was playing and advanced this frame
+  bool reset = false;     // A restart or rewind was applied first
+  StepEvents events;
+  std::vector<ImpactEvent> impacts;
+
+  // Profiled section times (ms) of the update, when it ran on the
+  // simulation thread; zero otherwise (and in unprofiled builds)
+  float profile[PROF_COUNT] = {};
+
+  RenderSnapshot() { impacts.reserve(AUDIO_IMPACT_EVENTS); }
+
+  int asteroidCount() const { return static_cast<int>(x.size()); }
+
+  // Also takes the world's pending impact events
+  void capture(World &world, const StepEvents &frameEvents) {
+    float alpha = world.interpolationAlpha();
+    tickCount = world.tickCount;
+    gameState = world.gameState;
+
+    player = world.player;
+    player.position = world.playerRenderPosition(alpha);
+    player.angle = world.playerRenderAngle(alpha);
+    wormhole = world.wormhole;
+    wormhole.rotation = lerpPeriodic(world.prevWormholeRotation,
+                                     world.wormhole.rotation, alpha, 360.0f);
+
+    const ObstacleField &field = world.asteroids;
+    int count = field.size();
+    // Bodies added since the last tick have no previous state
+    int blended = std::min(count, static_cast<int>(world.prevX.size()));
+    x.resize(count);
+    y.resize(count);
+    angle.resize(count);
+    for (int i = 0; i < blended; i++) {
+      x[i] = lerpPeriodic(world.prevX[i], field.x[i], alpha,
+                          tuning.worldWidth);
+      y[i] = lerpPeriodic(world.prevY[i], field.y[i], alpha,
+                          tuning.worldHeight);
+      angle[i] = lerpPeriodic(world.prevAngle[i], field.angle[i], alpha,
+                              360.0f);
+    }
+    std::copy(field.x.begin() + blended, field.x.end(), x.begin() + blended);
+    std::copy(field.y.begin() + blended, field.y.end(), y.begin() + blended);
+    std::copy(field.angle.begin() + blended, field.angle.end(),
+              angle.begin() + blended);
+    radius.assign(field.radius.begin(), field.radius.end());
+    textureIndex.assign(field.textureIndex.begin(), field.textureIndex.end());
+
+    events = frameEvents;
+    impacts.assign(world.impactEvents.begin(), world.impactEvents.end());
+    world.impactEvents.clear();
+  }
+};
+
+#endif
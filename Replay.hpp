@@ -0,0 +1,151 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Input log of one session: everything needed to re-run it tick for tick.
+//
+// File layout (little endian):
+//   "DAR2"              magic ("DAR1" files have no configHash)
+//   u32 tickRate        SIM_TICK_RATE the session ran at
+//   u64 seed            World seed
+//   u32 obstacleCount
+//   u64 configHash      Config::hash() of the tuning in effect
+//   runs...             until end of file
+// Each run is a flags byte followed by a LEB128 varint tick count; every
+// tick in the run has those flags. Thrust is usually held or released for
+// many ticks, so a session compresses to a few bytes per key press.
+class Replay {
+public:
+  enum Flags : std::uint8_t {
+    TICK_THRUST = 1 << 0,
+    TICK_RESTART = 1 << 1, // world.restart() before this tick
+  };
+
+  struct Run {
+    std::uint8_t flags;
+    std::uint32_t ticks;
+  };
+
+  std::uint32_t tickRate = 0;
+  std::uint64_t seed = 0;
+  std::uint32_t obstacleCount = 0;
+  std::uint64_t configHash = 0; // 0 = unknown (older file)
+  std::vector<Run> runs;
+
+  // Recording ---------------------------------------------------------------
+
+  void markRestart() { restartPending = true; }
+
+  void addTick(bool thrust) {
+    std::uint8_t flags = thrust ? TICK_THRUST : 0;
+    if (restartPending)
+      flags |= TICK_RESTART;
+    restartPending = false;
+
+    // A restart tick is never merged into the previous run
+    if (!runs.empty() && runs.back().flags == flags &&
+        !(flags & TICK_RESTART))
+      runs.back().ticks++;
+    else
+      runs.push_back({flags, 1});
+  }
+
+  long totalTicks() const {
+    long total = 0;
+    for (const Run &run : runs)
+      total += run.ticks;
+    return total;
+  }
+
+  bool save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+      std::cerr << "Warning: Could not write replay " << path << std::endl;
+      return false;
+    }
+    out.write("DAR2", 4);
+    writeInt(out, tickRate, 4);
+    writeInt(out, seed, 8);
+    writeInt(out, obstacleCount, 4);
+    writeInt(out, configHash, 8);
+    for (const Run &run : runs) {
+      out.put(static_cast<char>(run.flags));
+      std::uint32_t n = run.ticks;
+      do {
+        std::uint8_t byte = n & 0x7f;
+        n >>= 7;
+        out.put(static_cast<char>(n ? byte | 0x80 : byte));
+      } while (n);
+    }
+    return static_cast<bool>(out);
+  }
+
+  // Playback ----------------------------------------------------------------
+
+  bool load(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[4];
+    std::string version = in.read(magic, 4) ? std::string(magic, 4) : "";
+    if (version != "DAR1" && version != "DAR2") {
+      std::cerr << "Error: " << path << " is not a replay file" << std::endl;
+      return false;
+    }
+    tickRate = static_cast<std::uint32_t>(readInt(in, 4));
+    seed = readInt(in, 8);
+    obstacleCount = static_cast<std::uint32_t>(readInt(in, 4));
+    configHash = version == "DAR2" ? readInt(in, 8) : 0;
+    if (!in) {
+      std::cerr << "Error: truncated replay " << path << std::endl;
+      return false;
+    }
+    runs.clear();
+    int flags;
+    while ((flags = in.get()) != EOF) {
+      std::uint32_t n = 0;
+      int shift = 0;
+      int byte;
+      do {
+        byte = in.get();
+        if (byte == EOF) {
+          std::cerr << "Error: truncated replay " << path << std::endl;
+          return false;
+        }
+        n |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+        shift += 7;
+      } while (byte & 0x80);
+      runs.push_back({static_cast<std::uint8_t>(flags), n});
+    }
+    return true;
+  }
+
+  // Calls tick(thrust, restart) once per recorded tick, in order
+  template <typename Fn> void play(Fn &&tick) const {
+    for (const Run &run : runs)
+      for (std::uint32_t i = 0; i < run.ticks; i++)
+        tick((run.flags & TICK_THRUST) != 0,
+             i == 0 && (run.flags & TICK_RESTART) != 0);
+  }
+
+private:
+  bool restartPending = false;
+
+  static void writeInt(std::ofstream &out, std::uint64_t value, int bytes) {
+    for (int b = 0; b < bytes; b++)
+      out.put(static_cast<char>((value >> (8 * b)) & 0xff));
+  }
+
+  // Past the end this reads 0xff bytes and leaves the stream failed
+  static std::uint64_t readInt(std::ifstream &in, int bytes) {
+    std::uint64_t value = 0;
+    for (int b = 0; b < bytes; b++)
+      value |= static_cast<std::uint64_t>(in.get() & 0xff) << (8 * b);
+    return value;
+  }
+};
+
+#endif
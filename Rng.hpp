@@ -0,0 +1,36 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <cstdint>
+
+// Seedable generator owned by the simulation (xorshift64*, seeded through
+// SplitMix64). Unlike rand() it has no hidden global state and gives the
+// same sequence on every platform, so a seed fully reproduces a run.
+class Rng {
+public:
+  explicit Rng(std::uint64_t seed = 0) { reseed(seed); }
+
+  void reseed(std::uint64_t seed) {
+    // SplitMix64 spreads nearby seeds apart and never yields zero state
+    std::uint64_t z = seed + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    state = (z ^ (z >> 31)) | 1;
+  }
+
+  std::uint32_t next() {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return static_cast<std::uint32_t>((state * 0x2545f4914f6cdd1dull) >> 32);
+  }
+
+  // Integer in [0, n), drop-in for rand() % n
+  int below(int n) {
+    return static_cast<int>(next() % static_cast<std::uint32_t>(n));
+  }
+
+  std::uint64_t state; // Public so snapshots can save and restore it
+};
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef SIMULATIONTHREAD_HPP
+#define SIMULATIONTHREAD_HPP
+
+#include "Constants.h"
+#include "Profiler.hpp"
+#include "RenderSnapshot.hpp"
+#include "Snapshot.hpp"
+#include "World.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// What the render thread asks of one simulation frame
+struct FrameInput {
+  float dt = 0.0f;
+  PlayerInput input;
+  bool restart = false; // Only acted on after a win or loss
+  bool rewind = false;  // Back to the last checkpoint (not while recording)
+  bool idle = false;    // The next frame may be far off (IdleMode.hpp)
+};
+
+// Runs the World one frame behind the renderer. Each exchange() hands over
+// the new frame's input and returns the snapshot of the frame before it;
+// the simulation thread advances the world while the caller draws that
+// snapshot, so update N+1 overlaps draw N at the cost of one frame of
+// latency.
+//
+// The handoff is lock-free and lock-step: one request is in flight at a
+// time, so two snapshot buffers suffice. The simulation writes one while
+// the renderer reads the other, and a pair of sequence counters
+// (release/acquire) publishes each side's turn. Unthreaded, exchange()
+// updates inline and returns the current frame, which is the old
+// back-to-back loop.
+//
+// The world, its recording and the rewind checkpoints belong to the
+// simulation thread from construction until stop().
+class SimulationThread {
+public:
+  SimulationThread(World &world, bool threaded) : world(world) {
+    lastCheckpointTick = world.tickCount;
+    snapshots[0].capture(world, StepEvents{});
+    if (threaded)
+      worker = std::thread([this] { run(); });
+  }
+
+  ~SimulationThread() { stop(); }
+
+  SimulationThread(const SimulationThread &) = delete;
+  SimulationThread &operator=(const SimulationThread &) = delete;
+
+  bool threaded() const { return worker.joinable(); }
+
+  // Render thread only. The returned snapshot stays valid until the next
+  // call.
+  const RenderSnapshot &exchange(const FrameInput &frame) {
+    if (!threaded()) {
+      update(frame, snapshots[0]);
+      return snapshots[0];
+    }
+    long previous = requested.load(std::memory_order_relaxed);
+    // Usually already done: it ran while the last frame was drawn
+    while (completed.load(std::memory_order_acquire) != previous)
+      std::this_thread::yield();
+    pending = frame;
+    requested.store(previous + 1, std::memory_order_release);
+    return snapshots[previous % 2];
+  }
+
+  // Finishes the frame in flight and hands the world back to the caller
+  void stop() {
+    if (!threaded())
+      return;
+    running.store(false, std::memory_order_release);
+    worker.join();
+  }
+
+private:
+  World &world;
+  SnapshotHistory history;
+  long lastCheckpointTick = 0;
+
+  RenderSnapshot snapshots[2];
+  FrameInput pending;
+  alignas(64) std::atomic<long> requested{0}; // Frames handed over
+  alignas(64) std::atomic<long> completed{0}; // Frames simulated
+  std::atomic<bool> running{true};
+  std::thread worker; // Last member: starts once everything above exists
+
+  void update(const FrameInput &frame, RenderSnapshot &out) {
+    bool reset = false;
+    if (frame.restart && world.gameState != GAME_STATE_PLAYING) {
+      world.restart(); // Re-initialize system state
+      reset = true;
+    }
+    if (frame.rewind && !world.recording && history.rewind(world)) {
+      lastCheckpointTick = world.tickCount;
+      reset = true;
+    }
+
+    StepEvents events;
+    bool simulated = world.gameState == GAME_STATE_PLAYING;
+    if (simulated) {
+      events = world.advance(frame.dt, frame.input);
+      if (world.tickCount - lastCheckpointTick >= SNAPSHOT_INTERVAL_TICKS) {
+        history.push(world);
+        lastCheckpointTick = world.tickCount;
+      }
+    }
+    out.capture(world, events);
+    out.simulated = simulated;
+    out.reset = reset;
+  }
+
+  void run() {
+    long done = 0;
+    int idle = 0;
+    bool slowPoll = false; // The renderer said it is idling
+    while (true) {
+      bool stopping = !running.load(std::memory_order_acquire);
+      if (requested.load(std::memory_order_acquire) == done) {
+        if (stopping)
+          break;
+        // Spin briefly for the next frame, then stop burning the core
+        if (slowPoll)
+          std::this_thread::sleep_for(
+              std::chrono::milliseconds(SIM_THREAD_IDLE_POLL_MS));
+        else if (++idle < SIM_THREAD_SPINS)
+          std::this_thread::yield();
+        else
+          std::this_thread::sleep_for(
+              std::chrono::microseconds(SIM_THREAD_POLL_US));
+        continue;
+      }
+      idle = 0;
+      done++;
+      slowPoll = pending.idle;
+      RenderSnapshot &out = snapshots[done % 2];
+      update(pending, out);
+      profiler.copyFrame(out.profile); // Published with the snapshot
+      profiler.endFrame();
+      completed.store(done, std::memory_order_release);
+    }
+    // This thread's world sections; the render thread writes its own
+    profiler.writeCsv(PROFILER_SIM_CSV_PATH);
+    profiler.writeJson(PROFILER_SIM_JSON_PATH);
+  }
+};
+
+#endif
@@ -0,0 +1,376 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include "World.hpp"
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <type_traits>
+#include <vector>
+
+// Complete simulation state of a World as a flat, versioned byte blob.
+// Everything that influences future ticks is included (ship, wormhole,
+// asteroid columns, parked large-world chunks, game state, RNG); caches that
+// are rebuilt every tick (grid, solver batches) and render-only state (HUD,
+// interpolation) are not.
+// Fields are stored in native byte order, so blobs are meant for the
+// machine that wrote them.
+//
+// Layout: "DAS" + version byte, then the fields in visitWorld order.
+class Snapshot {
+public:
+  static constexpr std::uint8_t VERSION = 3;
+
+  std::vector<std::uint8_t> bytes;
+
+  static Snapshot capture(const World &world) {
+    Snapshot snapshot;
+    Writer writer{snapshot.bytes};
+    const std::uint8_t magic[4] = {'D', 'A', 'S', VERSION};
+    for (std::uint8_t b : magic)
+      writer.field(b);
+    visitWorld(writer, world);
+    return snapshot;
+  }
+
+  // Leaves the world untouched and returns false on a foreign or truncated
+  // blob
+  bool restore(World &world) const {
+    if (bytes.size() < 4 || bytes[0] != 'D' || bytes[1] != 'A' ||
+        bytes[2] != 'S' || bytes[3] != VERSION)
+      return false;
+    State state;
+    Reader reader{bytes, 4};
+    visitWorld(reader, state);
+    if (!reader.ok || reader.pos != bytes.size())
+      return false;
+
+    world.player = state.player;
+    world.wormhole = state.wormhole;
+    world.asteroids.assign(state.asteroids);
+    world.gameState = state.gameState;
+    world.tickCount = state.tickCount;
+    world.seed = state.seed;
+    world.rng = state.rng;
+    world.chunks.dormant = std::move(state.chunks.dormant);
+    world.chunks.centerChunk = state.chunks.centerChunk;
+    world.chunks.sweepCursor = state.chunks.sweepCursor;
+    world.accumulator = 0.0f;
+    world.savePrevious();
+    return true;
+  }
+
+  // XOR against a base snapshot, then run-length encode: unchanged bytes XOR
+  // to zero, so a checkpoint where little moved costs a few bytes per
+  // changed field. Layout: u32 target size, then (varint zero run, varint
+  // literal length, literal bytes) until the target is covered.
+  std::vector<std::uint8_t> deltaFrom(const Snapshot &base) const {
+    std::vector<std::uint8_t> out;
+    putU32(out, static_cast<std::uint32_t>(bytes.size()));
+    size_t i = 0;
+    while (i < bytes.size()) {
+      size_t zeros = 0;
+      while (i + zeros < bytes.size() && xorAt(base, i + zeros) == 0)
+        zeros++;
+      i += zeros;
+      // A literal ends at the first pair of unchanged bytes
+      size_t literal = 0;
+      while (i + literal < bytes.size() &&
+             !(xorAt(base, i + literal) == 0 &&
+               (i + literal + 1 >= bytes.size() ||
+                xorAt(base, i + literal + 1) == 0)))
+        literal++;
+      putVarint(out, zeros);
+      putVarint(out, literal);
+      for (size_t k = 0; k < literal; k++)
+        out.push_back(xorAt(base, i + k));
+      i += literal;
+    }
+    return out;
+  }
+
+  static bool applyDelta(const Snapshot &base,
+                         const std::vector<std::uint8_t> &delta,
+                         Snapshot &out) {
+    size_t pos = 0;
+    std::uint32_t size;
+    if (!getU32(delta, pos, size))
+      return false;
+    out.bytes.assign(size, 0);
+    std::memcpy(out.bytes.data(), base.bytes.data(),
+                std::min<size_t>(size, base.bytes.size()));
+    size_t i = 0;
+    while (i < size) {
+      std::uint64_t zeros, literal;
+      if (!getVarint(delta, pos, zeros) || !getVarint(delta, pos, literal) ||
+          i + zeros + literal > size || pos + literal > delta.size())
+        return false;
+      i += zeros;
+      for (std::uint64_t k = 0; k < literal; k++)
+        out.bytes[i++] ^= delta[pos++];
+    }
+    return pos == delta.size();
+  }
+
+private:
+  // The serialized subset of World, read into first so a bad blob never
+  // leaves the world half restored
+  struct State {
+    Astronaut player;
+    Goal wormhole;
+    ObstacleField asteroids;
+    int gameState = GAME_STATE_START;
+    long tickCount = 0;
+    std::uint64_t seed = 0;
+    Rng rng;
+    ObstacleChunks chunks;
+  };
+
+  struct Writer {
+    std::vector<std::uint8_t> &out;
+
+    template <typename T> void field(const T &value) {
+      static_assert(std::is_trivially_copyable<T>::value, "POD fields only");
+      const std::uint8_t *p = reinterpret_cast<const std::uint8_t *>(&value);
+      out.insert(out.end(), p, p + sizeof(T));
+    }
+    template <typename T> void column(const std::vector<T> &values) {
+      if (!values.empty()) {
+        const std::uint8_t *p =
+            reinterpret_cast<const std::uint8_t *>(values.data());
+        out.insert(out.end(), p, p + values.size() * sizeof(T));
+      }
+    }
+    void count(int n) { field(static_cast<std::int32_t>(n)); }
+    template <typename T>
+    void chunkMap(const std::map<int, std::vector<T>> &chunks) {
+      count(static_cast<int>(chunks.size()));
+      for (const auto &entry : chunks) {
+        field(entry.first);
+        count(static_cast<int>(entry.second.size()));
+        column(entry.second);
+      }
+    }
+  };
+
+  struct Reader {
+    const std::vector<std::uint8_t> &in;
+    size_t pos;
+    bool ok = true;
+    int lastCount = 0; // Length of the columns that follow count()
+
+    template <typename T> void field(T &value) {
+      if (take(sizeof(T)))
+        std::memcpy(&value, in.data() + pos - sizeof(T), sizeof(T));
+    }
+    template <typename T> void column(std::vector<T> &values) {
+      size_t n = static_cast<size_t>(lastCount);
+      if (!take(n * sizeof(T)))
+        return;
+      values.resize(n);
+      if (n)
+        std::memcpy(values.data(), in.data() + pos - n * sizeof(T),
+                    n * sizeof(T));
+    }
+    void count(int &) {
+      std::int32_t stored = 0;
+      if (take(sizeof stored))
+        std::memcpy(&stored, in.data() + pos - sizeof stored, sizeof stored);
+      if (stored < 0)
+        ok = false;
+      lastCount = ok ? stored : 0;
+    }
+    template <typename T> void chunkMap(std::map<int, std::vector<T>> &chunks) {
+      chunks.clear();
+      int n = 0;
+      count(n);
+      int entries = lastCount;
+      for (int k = 0; k < entries && ok; k++) {
+        int key = 0;
+        field(key);
+        count(n);
+        column(chunks[key]);
+      }
+    }
+    bool take(size_t n) {
+      if (!ok || pos + n > in.size()) {
+        ok = false;
+        return false;
+      }
+      pos += n;
+      return true;
+    }
+  };
+
+  // The single field list shared by capture (World) and restore (State)
+  template <typename Archive, typename W>
+  static void visitWorld(Archive &ar, W &world) {
+    auto &p = world.player;
+    ar.field(p.position);
+    ar.field(p.angle);
+    ar.field(p.rotationSpeed);
+    ar.field(p.velocity);
+    ar.field(p.thrustPower);
+    ar.field(p.oxygen);
+    ar.field(p.oxygenDrainRate);
+    ar.field(p.collisionDrainFactor);
+    ar.field(p.thrustCapacity);
+    ar.field(p.thrustDrainRate);
+    ar.field(p.isDead);
+    ar.field(p.currentShipState);
+    ar.field(p.isCurrentlyThrusting);
+    ar.field(p.angularVelocity);
+    ar.field(p.mass);
+    ar.field(p.inertia);
+
+    auto &g = world.wormhole;
+    ar.field(g.position);
+    ar.field(g.rotation);
+    ar.field(g.isReached);
+    ar.field(g.rotationSpeed);
+
+    ar.field(world.gameState);
+    ar.field(world.tickCount);
+    ar.field(world.seed);
+    ar.field(world.rng.state);
+
+    auto &f = world.asteroids;
+    int n = f.size();
+    ar.count(n);
+    ar.column(f.x);
+    ar.column(f.y);
+    ar.column(f.vx);
+    ar.column(f.vy);
+    ar.column(f.angle);
+    ar.column(f.omega);
+    ar.column(f.radius);
+    ar.column(f.invMass);
+    ar.column(f.textureIndex);
+
+    auto &c = world.chunks;
+    ar.field(c.centerChunk);
+    ar.field(c.sweepCursor);
+    ar.chunkMap(c.dormant);
+  }
+
+  std::uint8_t xorAt(const Snapshot &base, size_t i) const {
+    std::uint8_t b = i < base.bytes.size() ? base.bytes[i] : 0;
+    return bytes[i] ^ b;
+  }
+
+  static void putU32(std::vector<std::uint8_t> &out, std::uint32_t v) {
+    for (int b = 0; b < 4; b++)
+      out.push_back(static_cast<std::uint8_t>(v >> (8 * b)));
+  }
+  static bool getU32(const std::vector<std::uint8_t> &in, size_t &pos,
+                     std::uint32_t &v) {
+    if (pos + 4 > in.size())
+      return false;
+    v = 0;
+    for (int b = 0; b < 4; b++)
+      v |= static_cast<std::uint32_t>(in[pos++]) << (8 * b);
+    return true;
+  }
+  static void putVarint(std::vector<std::uint8_t> &out, std::uint64_t v) {
+    do {
+      std::uint8_t byte = v & 0x7f;
+      v >>= 7;
+      out.push_back(v ? byte | 0x80 : byte);
+    } while (v);
+  }
+  static bool getVarint(const std::vector<std::uint8_t> &in, size_t &pos,
+                        std::uint64_t &v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (pos >= in.size())
+        return false;
+      std::uint8_t byte = in[pos++];
+      v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+};
+
+// Rolling checkpoints for rewind. Every SNAPSHOT_KEYFRAME_INTERVAL-th entry
+// is a whole snapshot and the rest are deltas against the entry before, so
+// restoring replays at most one keyframe interval of deltas.
+class SnapshotHistory {
+public:
+  void push(const World &world) {
+    Snapshot current = Snapshot::capture(world);
+    Entry entry;
+    entry.keyframe = forceKeyframe || entries.empty() ||
+                     sinceKeyframe + 1 >= SNAPSHOT_KEYFRAME_INTERVAL;
+    entry.data = entry.keyframe ? current.bytes : current.deltaFrom(last);
+    sinceKeyframe = entry.keyframe ? 0 : sinceKeyframe + 1;
+    forceKeyframe = false;
+    entries.push_back(std::move(entry));
+    last = std::move(current);
+
+    // Drop whole keyframe groups from the front once over capacity
+    if (entries.size() > SNAPSHOT_HISTORY) {
+      entries.pop_front();
+      while (!entries.empty() && !entries.front().keyframe)
+        entries.pop_front();
+    }
+  }
+
+  // Restores the newest checkpoint and forgets it, so repeated calls step
+  // further back. Returns false when there is nothing left.
+  bool rewind(World &world) {
+    if (entries.empty())
+      return false;
+    Snapshot snapshot;
+    bool ok = reconstruct(entries.size() - 1, snapshot) &&
+              snapshot.restore(world);
+    entries.pop_back();
+    // The next push has no valid delta base any more
+    forceKeyframe = true;
+    return ok;
+  }
+
+  size_t size() const { return entries.size(); }
+
+  size_t bytes() const {
+    size_t total = 0;
+    for (const Entry &entry : entries)
+      total += entry.data.size();
+    return total;
+  }
+
+  void clear() {
+    entries.clear();
+    forceKeyframe = true;
+  }
+
+private:
+  struct Entry {
+    bool keyframe = false;
+    std::vector<std::uint8_t> data;
+  };
+
+  std::deque<Entry> entries;
+  Snapshot last;
+  int sinceKeyframe = 0;
+  bool forceKeyframe = true;
+
+  bool reconstruct(size_t index, Snapshot &out) const {
+    size_t key = index;
+    while (!entries[key].keyframe)
+      key--;
+    out.bytes = entries[key].data;
+    for (size_t i = key + 1; i <= index; i++) {
+      Snapshot next;
+      if (!Snapshot::applyDelta(out, entries[i].data, next))
+        return false;
+      out = std::move(next);
+    }
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef SPATIALGRID_HPP
+#define SPATIALGRID_HPP
+
+#include "Collision.hpp"
+#include "Config.hpp"
+#include "Constants.h"
+#include "ObstacleField.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Uniform-grid broad phase over the toroidal world.
+// Obstacles are binned by center with a counting sort (CSR layout:
+// cellStart[c]..cellStart[c + 1] indexes into entries), rebuilt each tick.
+// Queries test the wrapped distance, matching handleCollision.
+// Worlds wider than GRID_MAX_CELLS cells reuse the grid periodically: a cell
+// stands for every world cell congruent to it, so memory and rebuild cost
+// stay fixed while only the streamed-in region is populated. Aliased bodies
+// are rejected by the distance test.
+class SpatialGrid {
+public:
+  int cols;
+  int rows;
+  int spanCols; // World cells across, a multiple of cols
+  int spanRows;
+  float cellWidth;
+  float cellHeight;
+  float invCellWidth;
+  float invCellHeight;
+  float maxRadius = 0.f; // Largest radius binned in the last rebuild
+
+  std::vector<int> cellStart; // cols * rows + 1 offsets
+  std::vector<int> entries;   // Obstacle indices grouped by cell
+  std::vector<int> cellOf;    // Cell of each obstacle (rebuild scratch)
+  std::vector<int> cursor;    // Scatter write heads (rebuild scratch)
+
+  SpatialGrid() {
+    // Cells must tile the world exactly so wrapped indices stay aligned
+    spanCols =
+        std::max(1, static_cast<int>(tuning.worldWidth / GRID_CELL_SIZE));
+    spanRows =
+        std::max(1, static_cast<int>(tuning.worldHeight / GRID_CELL_SIZE));
+    cols = std::min(spanCols, GRID_MAX_CELLS);
+    rows = std::min(spanRows, GRID_MAX_CELLS);
+    spanCols -= spanCols % cols;
+    spanRows -= spanRows % rows;
+    cellWidth = static_cast<float>(tuning.worldWidth) / spanCols;
+    cellHeight = static_cast<float>(tuning.worldHeight) / spanRows;
+    invCellWidth = 1.0f / cellWidth;
+    invCellHeight = 1.0f / cellHeight;
+    cellStart.assign(cols * rows + 1, 0);
+  }
+
+  int wrapCol(int c) const { return ((c % cols) + cols) % cols; }
+  int wrapRow(int r) const { return ((r % rows) + rows) % rows; }
+
+  // Obstacles are always wrapped into [0, world size], so binning only clamps
+  int cellIndex(sf::Vector2f p) const {
+    int c = std::clamp(static_cast<int>(p.x * invCellWidth), 0, spanCols - 1);
+    int r = std::clamp(static_cast<int>(p.y * invCellHeight), 0, spanRows - 1);
+    return (r % rows) * cols + c % cols;
+  }
+
+  void rebuild(const ObstacleField &field) {
+    const int n = field.size();
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    cellOf.resize(n);
+    entries.resize(n);
+    maxRadius = 0.f;
+
+    // Count per cell
+    for (int i = 0; i < n; i++) {
+      cellOf[i] = cellIndex({field.x[i], field.y[i]});
+      cellStart[cellOf[i] + 1]++;
+    }
+    for (int i = 0; i < n; i++)
+      maxRadius = std::max(maxRadius, field.radius[i]);
+
+    // Prefix sum into offsets
+    for (size_t c = 1; c < cellStart.size(); c++)
+      cellStart[c] += cellStart[c - 1];
+
+    // Scatter; ascending index keeps each cell sorted
+    cursor.assign(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < n; i++)
+      entries[cursor[cellOf[i]]++] = i;
+  }
+
+  // Call fn(index) for every obstacle binned in a cell that overlaps the
+  // square of half-size reach around center, wrapping across the seams.
+  template <typename Fn>
+  void forEachInRange(sf::Vector2f center, float reach, Fn &&fn) const {
+    int c0 = static_cast<int>(std::floor((center.x - reach) * invCellWidth));
+    int c1 = static_cast<int>(std::floor((center.x + reach) * invCellWidth));
+    int r0 = static_cast<int>(std::floor((center.y - reach) * invCellHeight));
+    int r1 = static_cast<int>(std::floor((center.y + reach) * invCellHeight));
+
+    // Never visit a wrapped cell twice
+    if (c1 - c0 + 1 >= cols) {
+      c0 = 0;
+      c1 = cols - 1;
+    }
+    if (r1 - r0 + 1 >= rows) {
+      r0 = 0;
+      r1 = rows - 1;
+    }
+
+    for (int r = r0; r <= r1; r++) {
+      int row = wrapRow(r) * cols;
+      for (int c = c0; c <= c1; c++) {
+        int cell = row + wrapCol(c);
+        for (int k = cellStart[cell]; k < cellStart[cell + 1]; k++)
+          fn(entries[k]);
+      }
+    }
+  }
+
+  // Collect indices of obstacles that overlap a circle at center with the
+  // given radius. Cells are visited with the largest binned obstacle radius
+  // as margin, then each entry is distance-tested so the result stays small.
+  // Output is sorted ascending so narrow phase resolves in the same order as
+  // a brute-force sweep.
+  void query(sf::Vector2f center, float radius, const ObstacleField &field,
+             std::vector<int> &out) const {
+    out.clear();
+    forEachInRange(center, radius + maxRadius, [&](int index) {
+      sf::Vector2f diff = wrapOffset(center - field.position(index));
+      float minDistance = radius + field.radius[index];
+      if (diff.x * diff.x + diff.y * diff.y < minDistance * minDistance)
+        out.push_back(index);
+    });
+    std::sort(out.begin(), out.end());
+  }
+};
+
+#endif
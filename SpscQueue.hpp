@@ -0,0 +1,50 @@
+#ifndef SPSCQUEUE_HPP
+#define SPSCQUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+// Bounded lock-free ring for exactly one producer thread and one consumer
+// thread. Each side owns one index and only reads the other's, so push and
+// pop are a handful of loads and stores with no locks and no allocation.
+// Indices run freely and are masked on use; Capacity must be a power of
+// two. The indices sit on separate cache lines so the two threads do not
+// false-share.
+template <typename T, std::size_t Capacity> class SpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Elements are copied between threads as plain data");
+
+public:
+  // Producer only. Returns false, and leaves the queue untouched, when full.
+  bool push(const T &value) {
+    std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+    if (tail - headIndex.load(std::memory_order_acquire) == Capacity)
+      return false;
+    slots[tail & (Capacity - 1)] = value;
+    tailIndex.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only. Returns false when empty.
+  bool pop(T &value) {
+    std::size_t head = headIndex.load(std::memory_order_relaxed);
+    if (head == tailIndex.load(std::memory_order_acquire))
+      return false;
+    value = slots[head & (Capacity - 1)];
+    headIndex.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+  alignas(64) std::atomic<std::size_t> headIndex{0}; // Next slot to pop
+  alignas(64) std::atomic<std::size_t> tailIndex{0}; // Next slot to fill
+  alignas(64) std::array<T, Capacity> slots{};
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef TEXTUREATLAS_HPP
+#define TEXTUREATLAS_HPP
+
+#include "Constants.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+// Packs several images into one texture with a simple shelf packer so a
+// whole family of sprites can be drawn with a single texture bind.
+class TextureAtlas {
+public:
+  sf::Texture texture;
+  std::vector<sf::IntRect> rects; // Sub-rectangle of each packed image
+
+  bool build(const std::vector<sf::Image> &images) {
+    const unsigned maxWidth =
+        std::min(static_cast<unsigned>(ATLAS_MAX_WIDTH),
+                 sf::Texture::getMaximumSize());
+    const unsigned pad = ATLAS_PADDING;
+
+    // Place images left to right, starting a new shelf when a row is full
+    std::vector<sf::Vector2u> origins;
+    unsigned cursorX = 0, shelfY = 0, shelfHeight = 0, atlasWidth = 0;
+    for (const auto &image : images) {
+      sf::Vector2u size = image.getSize();
+      if (cursorX > 0 && cursorX + size.x > maxWidth) {
+        shelfY += shelfHeight + pad;
+        cursorX = 0;
+        shelfHeight = 0;
+      }
+      origins.push_back({cursorX, shelfY});
+      cursorX += size.x + pad;
+      shelfHeight = std::max(shelfHeight, size.y);
+      atlasWidth = std::max(atlasWidth, cursorX);
+    }
+    unsigned atlasHeight = shelfY + shelfHeight;
+
+    sf::Image atlas({std::max(atlasWidth, 1u), std::max(atlasHeight, 1u)},
+                    sf::Color::Transparent);
+    rects.clear();
+    for (size_t i = 0; i < images.size(); i++) {
+      if (!atlas.copy(images[i], origins[i])) {
+        std::cerr << "Warning: Could not pack image " << i << " into atlas"
+                  << std::endl;
+      }
+      rects.push_back({sf::Vector2i(origins[i]),
+                       sf::Vector2i(images[i].getSize())});
+    }
+
+    if (!texture.loadFromImage(atlas)) {
+      std::cerr << "Warning: Could not upload texture atlas" << std::endl;
+      return false;
+    }
+    texture.setSmooth(true);
+    // Asteroids are drawn far below their source resolution
+    if (!texture.generateMipmap()) {
+      std::cerr << "Warning: Could not generate atlas mipmaps" << std::endl;
+    }
+    return true;
+  }
+};
+
+#endif
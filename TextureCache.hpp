@@ -0,0 +1,235 @@
+#ifndef TEXTURECACHE_HPP
+#define TEXTURECACHE_HPP
+
+#include "AssetLoader.hpp"
+#include "TextureAtlas.hpp"
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Loads each texture file once, keyed by path. Textures live behind
+// unique_ptr so references stay valid however many entries are added.
+//
+// Files can be requested ahead of time: request() decodes on an AssetLoader
+// worker, and upload() (GL thread only) turns finished images into
+// textures. get() on a file that is still decoding waits for it.
+class TextureCache {
+public:
+  // Per-asset bookkeeping, kept in load order for the report
+  struct Record {
+    std::string key;
+    float loadMs = 0.0f;
+    size_t bytes = 0;
+    bool loaded = false;
+  };
+
+  std::vector<Record> records;
+
+  void request(const std::string &path, AssetLoader &loader) {
+    if (textures.count(path) || pending.count(path))
+      return;
+    auto job = std::make_unique<Pending>();
+    job->images.resize(1);
+    job->imageMs.resize(1);
+    queueDecode(*job, 0, path, loader);
+    pending.emplace(path, std::move(job));
+  }
+
+  // Each source image of the atlas is decoded by its own job
+  void requestAtlas(const std::string &name,
+                    const std::vector<std::string> &paths,
+                    AssetLoader &loader) {
+    if (atlases.count(name) || pending.count(name))
+      return;
+    auto job = std::make_unique<Pending>();
+    job->isAtlas = true;
+    job->images.resize(paths.size());
+    job->imageMs.resize(paths.size());
+    for (size_t i = 0; i < paths.size(); i++)
+      queueDecode(*job, i, paths[i], loader);
+    pending.emplace(name, std::move(job));
+  }
+
+  // Uploads every request whose decode has finished. Returns true once
+  // nothing is left pending.
+  bool upload() {
+    for (auto it = pending.begin(); it != pending.end();) {
+      if (it->second->decoded()) {
+        finish(it->first, *it->second);
+        it = pending.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    return pending.empty();
+  }
+
+  bool hasPending() const { return !pending.empty(); }
+
+  // True once the texture is uploaded and get() will not block
+  bool has(const std::string &key) const {
+    return textures.count(key) || atlases.count(key);
+  }
+
+  const sf::Texture &get(const std::string &path) {
+    auto it = textures.find(path);
+    if (it != textures.end())
+      return *it->second;
+
+    auto waiting = pending.find(path);
+    if (waiting != pending.end()) {
+      finish(path, *waiting->second);
+      pending.erase(waiting);
+      return *textures.at(path);
+    }
+
+    // Never requested: load synchronously
+    auto start = std::chrono::steady_clock::now();
+    auto texture = std::make_unique<sf::Texture>();
+    Record record;
+    record.key = path;
+    record.loaded = texture->loadFromFile(path);
+    if (!record.loaded) {
+      std::cerr << "Warning: Could not load " << path << std::endl;
+    }
+    record.loadMs = elapsedMs(start);
+    record.bytes = textureBytes(texture->getSize(), false);
+    records.push_back(record);
+
+    return *textures.emplace(path, std::move(texture)).first->second;
+  }
+
+  // Packs the given files into one atlas, cached under a caller-chosen name.
+  // The source images are decoded once and never kept as separate textures.
+  const TextureAtlas &atlas(const std::string &name,
+                            const std::vector<std::string> &paths) {
+    auto it = atlases.find(name);
+    if (it != atlases.end())
+      return *it->second;
+
+    auto waiting = pending.find(name);
+    if (waiting == pending.end()) {
+      // Never requested: decode inline
+      auto job = std::make_unique<Pending>();
+      job->isAtlas = true;
+      job->images.resize(paths.size());
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < paths.size(); i++) {
+        if (!job->images[i].loadFromFile(paths[i])) {
+          std::cerr << "Warning: Could not load " << paths[i] << std::endl;
+        }
+      }
+      job->decodeMs = elapsedMs(start);
+      waiting = pending.emplace(name, std::move(job)).first;
+    }
+    finish(name, *waiting->second);
+    pending.erase(waiting);
+    return *atlases.at(name);
+  }
+
+  size_t totalBytes() const {
+    size_t total = 0;
+    for (const auto &record : records)
+      total += record.bytes;
+    return total;
+  }
+
+  void report(std::ostream &out) const {
+    float totalMs = 0.0f;
+    for (const auto &record : records) {
+      out << std::fixed << std::setprecision(2) << std::setw(8)
+          << record.loadMs << " ms " << std::setw(8)
+          << record.bytes / 1024 << " KiB  " << record.key
+          << (record.loaded ? "" : "  (failed)") << "\n";
+      totalMs += record.loadMs;
+    }
+    out << std::setw(8) << totalMs << " ms " << std::setw(8)
+        << totalBytes() / 1024 << " KiB  total (" << records.size()
+        << " assets)" << std::endl;
+  }
+
+private:
+  // Images being decoded for one texture or atlas
+  struct Pending {
+    bool isAtlas = false;
+    std::vector<sf::Image> images;
+    std::vector<std::future<bool>> results;
+    std::vector<float> imageMs;
+    float decodeMs = 0.0f; // Summed decode time of all images
+
+    bool decoded() const {
+      for (const auto &result : results)
+        if (result.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready)
+          return false;
+      return true;
+    }
+  };
+
+  std::unordered_map<std::string, std::unique_ptr<sf::Texture>> textures;
+  std::unordered_map<std::string, std::unique_ptr<TextureAtlas>> atlases;
+  std::unordered_map<std::string, std::unique_ptr<Pending>> pending;
+
+  // The job writes only into its own image slot, which stays put because
+  // the Pending is heap allocated and its vectors are sized up front
+  static void queueDecode(Pending &job, size_t slot, const std::string &path,
+                          AssetLoader &loader) {
+    sf::Image *image = &job.images[slot];
+    float *ms = &job.imageMs[slot];
+    job.results.push_back(loader.add([image, ms, path] {
+      auto start = std::chrono::steady_clock::now();
+      bool ok = image->loadFromFile(path);
+      if (!ok) {
+        std::cerr << "Warning: Could not load " << path << std::endl;
+      }
+      *ms = elapsedMs(start);
+      return ok;
+    }));
+  }
+
+  // GL thread: waits for any outstanding decode, then uploads
+  void finish(const std::string &key, Pending &job) {
+    bool decodedOk = true;
+    for (auto &result : job.results)
+      decodedOk = result.get() && decodedOk;
+    for (float ms : job.imageMs)
+      job.decodeMs += ms;
+
+    auto start = std::chrono::steady_clock::now();
+    Record record;
+    record.key = key;
+    if (job.isAtlas) {
+      auto atlas = std::make_unique<TextureAtlas>();
+      record.loaded = atlas->build(job.images) && decodedOk;
+      record.bytes = textureBytes(atlas->texture.getSize(), true);
+      atlases.emplace(key, std::move(atlas));
+    } else {
+      auto texture = std::make_unique<sf::Texture>();
+      record.loaded = decodedOk && texture->loadFromImage(job.images[0]);
+      record.bytes = textureBytes(texture->getSize(), false);
+      textures.emplace(key, std::move(texture));
+    }
+    record.loadMs = job.decodeMs + elapsedMs(start);
+    records.push_back(record);
+  }
+
+  static float elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+
+  // RGBA8 estimate; a full mip chain adds about a third
+  static size_t textureBytes(sf::Vector2u size, bool mipmapped) {
+    size_t bytes = static_cast<size_t>(size.x) * size.y * 4;
+    return mipmapped ? bytes + bytes / 3 : bytes;
+  }
+};
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size fork/join pool. parallelFor splits [0, count) into one
+// contiguous chunk per thread (the caller runs chunk 0) and blocks until
+// every chunk is done. Work is statically partitioned, so callers that write
+// disjoint data per index get identical results for any thread count.
+class ThreadPool {
+public:
+  explicit ThreadPool(int threadCount = 0) {
+    if (threadCount <= 0)
+      threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, threadCount);
+    for (int i = 1; i < threadCount; i++)
+      workers.emplace_back([this, i] { workerLoop(i); });
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (auto &worker : workers)
+      worker.join();
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  int size() const { return static_cast<int>(workers.size()) + 1; }
+
+  // fn(begin, end) is called once per non-empty chunk. The callable is
+  // borrowed by pointer rather than wrapped in std::function, so dispatch
+  // never allocates.
+  template <typename Fn> void parallelFor(int count, const Fn &fn) {
+    if (count <= 0)
+      return;
+    if (workers.empty() || count < 2) {
+      fn(0, count);
+      return;
+    }
+
+    Job current{&fn, [](const void *context, int begin, int end) {
+                  (*static_cast<const Fn *>(context))(begin, end);
+                }};
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      job = current;
+      jobCount = count;
+      pending = static_cast<int>(workers.size());
+      generation++;
+    }
+    wake.notify_all();
+
+    runChunk(0, count, current);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return pending == 0; });
+    job = Job{};
+  }
+
+private:
+  struct Job {
+    const void *context = nullptr;
+    void (*invoke)(const void *, int, int) = nullptr;
+  };
+
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  Job job;
+  int jobCount = 0;
+  int pending = 0;
+  unsigned long generation = 0;
+  bool stopping = false;
+
+  void runChunk(int chunk, int count, const Job &fn) const {
+    int chunks = size();
+    int begin = static_cast<int>(static_cast<long long>(count) * chunk / chunks);
+    int end =
+        static_cast<int>(static_cast<long long>(count) * (chunk + 1) / chunks);
+    if (begin < end)
+      fn.invoke(fn.context, begin, end);
+  }
+
+  void workerLoop(int chunk) {
+    unsigned long seen = 0;
+    while (true) {
+      Job fn;
+      int count;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping)
+          return;
+        seen = generation;
+        fn = job;
+        count = jobCount;
+      }
+
+      runChunk(chunk, count, fn);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending--;
+      }
+      done.notify_one();
+    }
+  }
+};
+
+#endif
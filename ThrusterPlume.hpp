@@ -0,0 +1,118 @@
+#ifndef THRUSTERPLUME_HPP
+#define THRUSTERPLUME_HPP
+
+#include "Astronaut.hpp"
+#include "Config.hpp"
+#include "Constants.h"
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdint>
+
+// Procedural engine exhaust for any number of ships, batched into one
+// triangle list. The list is cleared and refilled in place every frame
+// (its storage is kept), so a frame's plumes cost no allocations and one
+// draw call however many ships are thrusting. Flicker state lives in a
+// per-ship Animation owned by the caller.
+class ThrusterPlume {
+public:
+  // Flicker phase of one ship's exhaust
+  struct Animation {
+    float time = 0.0f;
+  };
+
+  void clear() { vertices.clear(); }
+
+  // Appends one ship's nozzle and plume; pos and angle are its drawn pose
+  void add(const Astronaut &ship, sf::Vector2f pos, float angle,
+           Animation &animation) {
+    if (!ship.has_thrust())
+      return;
+
+    float rotatedAngle = angle + 180.0f;
+    float rad = rotatedAngle * (3.14159f / 180.0f);
+    sf::Vector2f direction(std::cos(rad), std::sin(rad));
+    sf::Vector2f perpendicular(-direction.y, direction.x);
+
+    // NOZZLE
+    float nLen = 8.0f;
+    float nWid = 6.0f;
+    sf::Vector2f nOffset = direction * nLen;
+    sf::Color nozzleColor = ship.isCurrentlyThrusting
+                                ? sf::Color(100, 100, 110) // Active grey
+                                : sf::Color(30, 30, 35);   // Cold dark grey
+    quad(pos + perpendicular * nWid, pos - perpendicular * nWid,
+         pos + nOffset - perpendicular * (nWid * 0.8f),
+         pos + nOffset + perpendicular * (nWid * 0.8f), nozzleColor);
+
+    if (!ship.isCurrentlyThrusting) {
+      // Pilot light
+      disc(pos + nOffset * 0.6f, 2.0f, sf::Color(80, 80, 80, 100));
+      return;
+    }
+
+    float tRatio = ship.thrustCapacity / tuning.thrustCapacityMax;
+    float maxLen = POINTER_WIDTH * 1.5f * tRatio;
+    float maxWid = 10.0f;
+
+    // Flickering physics
+    animation.time += 0.4f;
+    float flicker = 0.95f + (std::sin(animation.time) * 0.05f);
+
+    sf::Color pColor = (ship.currentShipState < 2) ? sf::Color(0, 255, 255)
+                                                   : sf::Color(255, 100, 0);
+
+    // Three-layer bloom/glow, outermost first
+    for (int i = 3; i > 0; i--) {
+      float s = i * 0.33f;
+      float l = maxLen * s * flicker;
+      float w = maxWid * s;
+      sf::Color c = pColor;
+      c.a = static_cast<std::uint8_t>(80 / i);
+      triangle(pos + perpendicular * w, pos - perpendicular * w,
+               pos + direction * l, c);
+    }
+
+    // High-intensity plasma core
+    triangle(pos + perpendicular * (maxWid * 0.3f),
+             pos - perpendicular * (maxWid * 0.3f),
+             pos + direction * (maxLen * 0.4f), sf::Color::White);
+  }
+
+  void draw(sf::RenderTarget &target) const {
+    if (vertices.getVertexCount() > 0)
+      target.draw(vertices);
+  }
+
+  std::size_t vertexCount() const { return vertices.getVertexCount(); }
+
+private:
+  sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+
+  void triangle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c,
+                sf::Color color) {
+    vertices.append({a, color, {}});
+    vertices.append({b, color, {}});
+    vertices.append({c, color, {}});
+  }
+
+  // Convex, corners in winding order
+  void quad(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d,
+            sf::Color color) {
+    triangle(a, b, c, color);
+    triangle(a, c, d, color);
+  }
+
+  void disc(sf::Vector2f center, float radius, sf::Color color) {
+    const int segments = 8; // Two pixels across needs little more
+    sf::Vector2f previous = center + sf::Vector2f(radius, 0.0f);
+    for (int k = 1; k <= segments; k++) {
+      float a = k * (2.0f * 3.14159f / segments);
+      sf::Vector2f next =
+          center + sf::Vector2f(std::cos(a), std::sin(a)) * radius;
+      triangle(center, previous, next, color);
+      previous = next;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef UILAYER_HPP
+#define UILAYER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Screen-space text centered on an anchor. Glyph layout (bounds, origin,
+// position) is redone only when the string or anchor changes, not every
+// frame. Colors and outline colors can change freely since they do not
+// move glyphs; after changing size, style or outline thickness, call
+// invalidate().
+class UiText {
+public:
+  sf::Text text;
+
+  UiText(const sf::Font &font, const std::string &string, unsigned size,
+         sf::Vector2f anchor)
+      : text(font, string, size), current(string), anchor(anchor) {}
+
+  void setString(const std::string &string) {
+    if (string == current)
+      return;
+    current = string;
+    text.setString(string);
+    dirty = true;
+  }
+
+  void setAnchor(sf::Vector2f position) {
+    if (position == anchor)
+      return;
+    anchor = position;
+    dirty = true;
+  }
+
+  void invalidate() { dirty = true; }
+  bool changed() const { return dirty; }
+
+  void layout() {
+    if (!dirty)
+      return;
+    sf::FloatRect bounds = text.getLocalBounds();
+    text.setOrigin({bounds.size.x / 2.0f, bounds.size.y / 2.0f});
+    text.setPosition(anchor);
+    dirty = false;
+    layouts++;
+  }
+
+  void draw(sf::RenderTarget &target) {
+    layout();
+    target.draw(text);
+  }
+
+  long layouts = 0; // Times the glyphs were re-laid out
+
+private:
+  std::string current;
+  sf::Vector2f anchor;
+  bool dirty = true;
+};
+
+// A group of UiTexts that only changes on content changes, cached as one
+// window-sized sf::RenderTexture. When a member changes, the group is
+// redrawn into the texture; otherwise it is composited with a single
+// sprite draw. If no render texture can be created, the members are drawn
+// directly (still laid out only on change).
+class UiLayer {
+public:
+  long rebuilds = 0; // Times the cache was redrawn
+
+  UiText &add(const sf::Font &font, const std::string &string, unsigned size,
+              sf::Vector2f anchor) {
+    items.push_back(std::make_unique<UiText>(font, string, size, anchor));
+    dirty = true;
+    return *items.back();
+  }
+
+  UiText &operator[](size_t i) { return *items[i]; }
+
+  void invalidate() { dirty = true; }
+
+  // The target must be on its default view
+  void draw(sf::RenderTarget &target) {
+    for (const auto &item : items)
+      dirty = dirty || item->changed();
+    if (!prepare(target.getSize())) {
+      for (const auto &item : items)
+        item->draw(target);
+      return;
+    }
+    if (dirty) {
+      cache.clear(sf::Color::Transparent);
+      for (const auto &item : items)
+        item->draw(cache);
+      cache.display();
+      dirty = false;
+      rebuilds++;
+    }
+    // Drawing onto transparent black leaves the cache premultiplied
+    target.draw(*sprite, sf::RenderStates(sf::BlendMode(
+                             sf::BlendMode::Factor::One,
+                             sf::BlendMode::Factor::OneMinusSrcAlpha)));
+  }
+
+private:
+  std::vector<std::unique_ptr<UiText>> items;
+  sf::RenderTexture cache;
+  std::unique_ptr<sf::Sprite> sprite;
+  bool dirty = true;
+  bool uncached = false; // Render textures unavailable
+
+  bool prepare(sf::Vector2u size) {
+    if (uncached)
+      return false;
+    if (sprite && cache.getSize() == size)
+      return true;
+    if (!cache.resize(size)) {
+      uncached = true;
+      return false;
+    }
+    sprite = std::make_unique<sf::Sprite>(cache.getTexture());
+    dirty = true;
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef VOICEPOOL_HPP
+#define VOICEPOOL_HPP
+
+#include "Constants.h"
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+// Fixed set of sf::Sound voices shared by every one-shot effect, so
+// overlapping impacts layer instead of cutting each other off. Each play
+// takes a free voice; when all are busy it steals the quietest voice of
+// equal or lower priority (oldest on ties), and a request that would only
+// displace something louder or more important is dropped. Owned and
+// driven by the audio thread; the counters are atomics so the game thread
+// can report them.
+class VoicePool {
+public:
+  // Counters for sizing AUDIO_VOICES
+  std::atomic<int> peakActive{0};
+  std::atomic<int> peakStealsPerSecond{0};
+  std::atomic<long> plays{0};
+  std::atomic<long> steals{0};
+  std::atomic<long> drops{0};
+
+  // sf::Sound has no empty state, so voices start on any loaded buffer
+  void init(const sf::SoundBuffer &placeholder) {
+    voices.clear();
+    for (int i = 0; i < AUDIO_VOICES; i++)
+      voices.push_back({std::make_unique<sf::Sound>(placeholder), 0, 0.f, 0});
+    windowStart = Clock::now();
+  }
+
+  bool ready() const { return !voices.empty(); }
+
+  // volume is 0-100, pan -1 (left) to 1 (right)
+  bool play(const sf::SoundBuffer &buffer, int priority, float volume,
+            float pan) {
+    if (voices.empty())
+      return false;
+
+    Voice *target = nullptr;
+    int active = 0;
+    for (Voice &voice : voices) {
+      if (voice.sound->getStatus() != sf::SoundSource::Status::Playing) {
+        if (!target)
+          target = &voice;
+      } else {
+        active++;
+      }
+    }
+
+    if (!target) {
+      Voice *victim = nullptr;
+      for (Voice &voice : voices) {
+        if (voice.priority > priority)
+          continue;
+        if (!victim || voice.volume < victim->volume ||
+            (voice.volume == victim->volume &&
+             voice.sequence < victim->sequence))
+          victim = &voice;
+      }
+      // Never cut a louder sound of the same priority for a quieter one
+      if (!victim ||
+          (victim->priority == priority && victim->volume > volume)) {
+        drops.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      victim->sound->stop();
+      target = victim;
+      active--;
+      steals.fetch_add(1, std::memory_order_relaxed);
+      stealsThisWindow++;
+    }
+
+    target->sound->setBuffer(buffer);
+    target->sound->setVolume(volume);
+    target->sound->setPan(pan);
+    target->sound->play();
+    target->priority = priority;
+    target->volume = volume;
+    target->sequence = nextSequence++;
+
+    plays.fetch_add(1, std::memory_order_relaxed);
+    peakActive.store(std::max(peakActive.load(std::memory_order_relaxed),
+                              active + 1),
+                     std::memory_order_relaxed);
+    return true;
+  }
+
+  // Called every audio-thread iteration to close one-second windows
+  void update() {
+    if (voices.empty())
+      return;
+    Clock::time_point now = Clock::now();
+    if (now - windowStart < std::chrono::seconds(1))
+      return;
+    peakStealsPerSecond.store(
+        std::max(peakStealsPerSecond.load(std::memory_order_relaxed),
+                 stealsThisWindow),
+        std::memory_order_relaxed);
+    stealsThisWindow = 0;
+    windowStart = now;
+  }
+
+  void stopAll() {
+    for (Voice &voice : voices)
+      voice.sound->stop();
+  }
+
+  // Safe from any thread
+  void report(std::ostream &out) const {
+    double seconds =
+        std::chrono::duration<double>(Clock::now() - started).count();
+    long stolen = steals.load(std::memory_order_relaxed);
+    out << "Audio voices: peak " << peakActive.load() << "/" << AUDIO_VOICES
+        << ", plays " << plays.load() << ", steals " << stolen << " ("
+        << (seconds > 0 ? stolen / seconds : 0.0) << "/s, peak "
+        << peakStealsPerSecond.load() << "/s), dropped " << drops.load()
+        << std::endl;
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Voice {
+    std::unique_ptr<sf::Sound> sound;
+    int priority;
+    float volume;
+    long sequence; // Start order, for oldest-first stealing
+  };
+
+  std::vector<Voice> voices;
+  long nextSequence = 0;
+  int stealsThisWindow = 0;
+  Clock::time_point windowStart;
+  Clock::time_point started = Clock::now();
+};
+
+#endif
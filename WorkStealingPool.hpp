@@ -0,0 +1,93 @@
+#ifndef WORKSTEALINGPOOL_HPP
+#define WORKSTEALINGPOOL_HPP
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs a batch of independent, unevenly sized tasks across all cores.
+// Each worker starts with a contiguous block of task indices and takes
+// from the front of its own deque. A worker that runs dry steals from the
+// back of another's, so long tasks don't leave cores idle at the end of a
+// batch. Unlike ThreadPool::parallelFor the assignment of tasks to threads
+// is dynamic, so tasks must write only to their own outputs.
+class WorkStealingPool {
+public:
+  explicit WorkStealingPool(int threadCount = 0) {
+    if (threadCount <= 0)
+      threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    this->threadCount = std::max(1, threadCount);
+  }
+
+  int size() const { return threadCount; }
+
+  // Calls task(i) once for every i in [0, count) and blocks until all are
+  // done. The calling thread works as worker 0.
+  void run(int count, const std::function<void(int)> &task) {
+    int workers = std::max(1, std::min(threadCount, count));
+    queues.clear();
+    for (int w = 0; w < workers; w++) {
+      queues.push_back(std::make_unique<Queue>());
+      int begin = static_cast<int>(static_cast<long>(count) * w / workers);
+      int end = static_cast<int>(static_cast<long>(count) * (w + 1) / workers);
+      for (int i = begin; i < end; i++)
+        queues[w]->tasks.push_back(i);
+    }
+
+    std::vector<std::thread> threads;
+    for (int w = 1; w < workers; w++)
+      threads.emplace_back([this, w, &task] { workerLoop(w, task); });
+    workerLoop(0, task);
+    for (auto &thread : threads)
+      thread.join();
+  }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<int> tasks;
+  };
+
+  int threadCount;
+  std::vector<std::unique_ptr<Queue>> queues;
+
+  // No tasks are added during a run, so once every deque is empty the
+  // batch is finished
+  void workerLoop(int self, const std::function<void(int)> &task) {
+    int workers = static_cast<int>(queues.size());
+    for (;;) {
+      int index = -1;
+      if (!popFront(*queues[self], index)) {
+        for (int k = 1; k < workers && index < 0; k++)
+          popBack(*queues[(self + k) % workers], index);
+        if (index < 0)
+          return;
+      }
+      task(index);
+    }
+  }
+
+  static bool popFront(Queue &queue, int &index) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+      return false;
+    index = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+  }
+
+  static bool popBack(Queue &queue, int &index) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+      return false;
+    index = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,499 @@
+#ifndef WORLD_HPP
+#define WORLD_HPP
+
+#include "Astronaut.hpp"
+#include "Collision.hpp"
+#include "Config.hpp"
+#include "Constants.h"
+#include "Goal.hpp"
+#include "ObstacleChunks.hpp"
+#include "ObstacleField.hpp"
+#include "ObstacleFragmenter.hpp"
+#include "ObstacleSolver.hpp"
+#include "Profiler.hpp"
+#include "Replay.hpp"
+#include "Rng.hpp"
+#include "SpatialGrid.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Player intent sampled once per tick
+struct PlayerInput {
+  bool thrust = false;
+};
+
+// Outcome of a single tick, consumed by audio/UI on the windowed side
+struct StepEvents {
+  int collisions = 0;
+  int obstacleContacts = 0;
+  int fragments = 0; // Asteroids split this step
+  bool thrusting = false;
+  bool won = false;
+  bool lost = false;
+};
+
+// An asteroid-asteroid impact for positional audio
+struct ImpactEvent {
+  sf::Vector2f position; // Contact point, world coordinates
+  float impulse;
+};
+
+// Interpolates along the shorter way around a periodic axis (wrapped world
+// coordinates, degrees) so objects crossing the seam are not smeared across
+// the screen. The result is wrapped back into [0, period).
+inline float lerpPeriodic(float from, float to, float t, float period) {
+  float delta = to - from;
+  if (delta > period * 0.5f)
+    delta -= period;
+  else if (delta < -period * 0.5f)
+    delta += period;
+  float value = from + delta * t;
+  if (value < 0.0f)
+    value += period;
+  else if (value >= period)
+    value -= period;
+  return value;
+}
+
+// Complete gameplay state with a render-free tick. Owned by main() for the
+// windowed game and by the headless driver for profiling and CI runs.
+class World {
+public:
+  Astronaut player;
+  Goal wormhole;
+  ObstacleField asteroids;
+  int gameState = GAME_STATE_START;
+  long tickCount = 0; // Ticks simulated since construction
+
+  // Every random draw comes from here, so the seed reproduces a run
+  std::uint64_t seed;
+  Rng rng;
+  Replay *recording = nullptr; // Receives every tick's input when set
+
+  // Broad phase for the asteroid pair search; brute force is kept as the
+  // reference path for benchmarks and is used anyway below
+  // GRID_MIN_OBSTACLES. The ship only queries the grid on steps that build
+  // it for the solver: for a single query, rebuilding it costs more than
+  // testing every asteroid.
+  SpatialGrid grid;
+  bool useBroadPhase = true;
+  std::vector<int> candidates;
+  bool gridFresh = false; // Grid already rebuilt for this step
+
+  ObstacleSolver obstacleSolver;
+  bool resolveObstacleContacts = true;
+  ObstacleFragmenter fragmenter;
+
+  // The loudest AUDIO_IMPACT_EVENTS asteroid impacts since the consumer
+  // last cleared the list; only gathered when collectImpacts is set
+  bool collectImpacts = false;
+  std::vector<ImpactEvent> impactEvents;
+
+  // Large worlds only simulate asteroids near the ship; `asteroids` then
+  // holds the active region and the rest are parked here
+  ObstacleChunks chunks;
+
+  // Fixed-timestep accumulator: unsimulated time carried between frames
+  float accumulator = 0.0f;
+
+  // State before the most recent tick, for render interpolation
+  sf::Vector2f prevPlayerPosition;
+  float prevPlayerAngle = 0.0f;
+  float prevWormholeRotation = 0.0f;
+  std::vector<float> prevX, prevY, prevAngle;
+
+  explicit World(int obstacleCount = tuning.numObstacles,
+                 int solverThreads = tuning.solverThreads,
+                 std::uint64_t seed = DEFAULT_SEED)
+      : seed(seed), rng(seed), obstacleSolver(solverThreads) {
+    impactEvents.reserve(AUDIO_IMPACT_EVENTS);
+    spawnObstacles(obstacleCount);
+    if (chunks.enabled)
+      chunks.reset(asteroids, player.position, tickCount);
+    savePrevious();
+  }
+
+  void spawnObstacles(int count) {
+    // Populate world with randomized obstacles
+    asteroids.clear();
+    asteroids.reserve(count + OBSTACLE_POOL_HEADROOM);
+    for (int i = 0; i < count; i++) {
+      // One draw per statement: argument evaluation order is unspecified
+      float px = rng.below(tuning.worldWidth) * 0.8f;
+      float py = rng.below(tuning.worldHeight) * 0.8f;
+      float vx = static_cast<float>(rng.below(100) - 50);
+      float vy = static_cast<float>(rng.below(100) - 50);
+      float r = static_cast<float>(rng.below(tuning.maxObstacleRadius) +
+                                   tuning.minObstacleRadius);
+      // Initial angular velocity in [-60, 60) deg/s
+      float spin = static_cast<float>(rng.below(120) - 60);
+      asteroids.add(i % NUM_ASTEROID_TEXTURES, {px, py}, {vx, vy}, r, spin);
+    }
+  }
+
+  // Ship spin on (re)start, in [50, 150) deg/s
+  float startSpin() { return static_cast<float>(rng.below(100) + 50); }
+
+  // Leave the launch screen
+  void start() {
+    gameState = GAME_STATE_PLAYING;
+    player.reset(startSpin());
+    accumulator = 0.0f;
+    streamChunks();
+    savePrevious();
+  }
+
+  // Re-initialize after a win or loss
+  void restart() {
+    if (recording)
+      recording->markRestart();
+    player.reset(startSpin());
+    wormhole.reset();
+    gameState = GAME_STATE_PLAYING;
+    accumulator = 0.0f;
+    streamChunks();
+    savePrevious();
+  }
+
+  // Keep the active region centered on the ship
+  void streamChunks() {
+    if (chunks.enabled)
+      chunks.update(asteroids, player.position, tickCount);
+  }
+
+  // Runs as many SIM_DT ticks as the elapsed frame time allows (at most
+  // MAX_SUBSTEPS) and returns their combined events. The remainder stays in
+  // the accumulator; interpolationAlpha() says how far into the next tick
+  // the frame is.
+  StepEvents advance(float frameDt, const PlayerInput &input) {
+    accumulator += std::min(frameDt, SIM_DT * MAX_SUBSTEPS);
+
+    StepEvents total;
+    total.thrusting = input.thrust && player.has_thrust();
+    while (accumulator >= SIM_DT && gameState == GAME_STATE_PLAYING) {
+      StepEvents tick = this->tick(input);
+      accumulator -= SIM_DT;
+
+      total.collisions += tick.collisions;
+      total.obstacleContacts += tick.obstacleContacts;
+      total.fragments += tick.fragments;
+      total.thrusting = tick.thrusting;
+      total.won = total.won || tick.won;
+      total.lost = total.lost || tick.lost;
+    }
+    if (gameState != GAME_STATE_PLAYING)
+      accumulator = 0.0f;
+    return total;
+  }
+
+  // One SIM_DT step, recorded when a replay is attached. Drivers that do not
+  // need frame pacing (headless, replays) call this directly.
+  StepEvents tick(const PlayerInput &input) {
+    streamChunks();
+    savePrevious();
+    if (recording)
+      recording->addTick(input.thrust);
+    tickCount++;
+    return step(SIM_DT, input);
+  }
+
+  float interpolationAlpha() const { return accumulator / SIM_DT; }
+
+  // Player pose blended between the last two ticks
+  sf::Vector2f playerRenderPosition(float alpha) const {
+    return {lerpPeriodic(prevPlayerPosition.x, player.position.x, alpha,
+                         tuning.worldWidth),
+            lerpPeriodic(prevPlayerPosition.y, player.position.y, alpha,
+                         tuning.worldHeight)};
+  }
+
+  float playerRenderAngle(float alpha) const {
+    return lerpPeriodic(prevPlayerAngle, player.angle, alpha, 360.0f);
+  }
+
+  // FNV-1a over the full dynamic state; equal hashes mean identical runs
+  std::uint64_t stateHash() const {
+    std::uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](float v) {
+      std::uint32_t bits;
+      std::memcpy(&bits, &v, sizeof bits);
+      for (int b = 0; b < 4; b++) {
+        h ^= (bits >> (8 * b)) & 0xff;
+        h *= 1099511628211ull;
+      }
+    };
+    for (int i = 0; i < asteroids.size(); i++) {
+      mix(asteroids.x[i]);
+      mix(asteroids.y[i]);
+      mix(asteroids.vx[i]);
+      mix(asteroids.vy[i]);
+      mix(asteroids.omega[i]);
+    }
+    for (const auto &chunk : chunks.dormant) {
+      for (const DormantObstacle &body : chunk.second) {
+        mix(body.x);
+        mix(body.y);
+        mix(body.vx);
+        mix(body.vy);
+        mix(body.omega);
+      }
+    }
+    mix(player.position.x);
+    mix(player.position.y);
+    mix(player.velocity.x);
+    mix(player.velocity.y);
+    mix(player.angle);
+    mix(player.oxygen);
+    return h;
+  }
+
+  void savePrevious() {
+    prevPlayerPosition = player.position;
+    prevPlayerAngle = player.angle;
+    prevWormholeRotation = wormhole.rotation;
+    prevX = asteroids.x;
+    prevY = asteroids.y;
+    prevAngle = asteroids.angle;
+  }
+
+  StepEvents step(float dt, const PlayerInput &input) {
+    StepEvents events;
+    if (gameState != GAME_STATE_PLAYING)
+      return events;
+
+    events.thrusting = input.thrust && player.has_thrust();
+
+    {
+      PROFILE_SCOPE(PROF_PLAYER);
+      player.update(dt, events.thrusting);
+      wormhole.update(dt);
+    }
+
+    {
+      PROFILE_SCOPE(PROF_OBSTACLES);
+      asteroids.integrate(dt);
+    }
+
+    fragmenter.beginStep(asteroids.size());
+    {
+      PROFILE_SCOPE(PROF_COLLISIONS);
+      if (sweepShip(dt))
+        events.collisions++;
+      events.collisions += collideShip();
+    }
+
+    // Ship contacts only change obstacle velocities, so the grid is still
+    // exact for the asteroid pair search
+    if (resolveObstacleContacts) {
+      PROFILE_SCOPE(PROF_SOLVER);
+      events.obstacleContacts =
+          obstacleSolver.solve(asteroids, solverUsesGrid() ? &grid : nullptr);
+      if (collectImpacts)
+        recordImpactEvents();
+    }
+
+    if (tuning.fragmentImpulse > 0.0f) {
+      PROFILE_SCOPE(PROF_FRAGMENTS);
+      events.fragments = fragmenter.apply(
+          asteroids, resolveObstacleContacts ? &obstacleSolver : nullptr,
+          prevX, prevY, prevAngle);
+    }
+
+    wormhole.checkCollision(player.getPosition(), player.getRadius());
+
+    // Termination condition evaluation
+    if (wormhole.isReached) {
+      gameState = GAME_STATE_WON;
+      events.won = true;
+    }
+    if (player.isDead) {
+      gameState = GAME_STATE_LOST;
+      events.lost = true;
+    }
+    return events;
+  }
+
+  // Continuous ship-vs-asteroid test. A pair whose relative displacement
+  // this step exceeds the smaller radius could pass clean through between
+  // discrete checks, so it is swept instead. Only the earliest impact is
+  // resolved: the ship is moved to the touching pose, takes the impact, and
+  // finishes the step with its new velocity. Offsets use the shortest way
+  // around the torus, so sweeps crossing the wrap seam are caught too.
+  // Returns true when an impact was found.
+  bool sweepShip(float dt) {
+    float shipStep = std::sqrt(player.velocity.x * player.velocity.x +
+                               player.velocity.y * player.velocity.y) *
+                     dt;
+    float obstacleStep = 0.0f;
+    for (int i = 0; i < asteroids.size(); i++)
+      obstacleStep = std::max(obstacleStep, asteroids.vx[i] * asteroids.vx[i] +
+                                                asteroids.vy[i] * asteroids.vy[i]);
+    obstacleStep = std::sqrt(obstacleStep) * dt;
+
+    // Nothing can cover a radius this step: the discrete test is exact
+    float minRadius =
+        std::min(player.getRadius(),
+                 static_cast<float>(tuning.minObstacleRadius));
+    if (shipStep + obstacleStep <= minRadius)
+      return false;
+
+    int hit = -1;
+    float hitToi = 1.0f;
+    sf::Vector2f hitStart, hitMotion;
+    auto test = [&](int i) {
+      sf::Vector2f motion = (player.velocity - asteroids.velocity(i)) * dt;
+      float smaller = std::min(player.getRadius(), asteroids.radius[i]);
+      if (motion.x * motion.x + motion.y * motion.y <= smaller * smaller)
+        return;
+      float radiusSum = player.getRadius() + asteroids.radius[i];
+      sf::Vector2f end = player.position - asteroids.position(i);
+      end = {wrapDelta(end.x, tuning.worldWidth),
+             wrapDelta(end.y, tuning.worldHeight)};
+      sf::Vector2f start = end - motion;
+      float toi;
+      // Earliest impact wins; ties go to the lower index
+      if (sweptCircleTOI(start, motion, radiusSum, toi) &&
+          (toi < hitToi || (toi == hitToi && i < hit))) {
+        hit = i;
+        hitToi = toi;
+        hitStart = start;
+        hitMotion = motion;
+      }
+    };
+
+    if (shipUsesGrid()) {
+      grid.rebuild(asteroids);
+      gridFresh = true;
+      // Everything within reach of the swept segment, including across the
+      // seam (forEachInRange visits wrapped cells)
+      float reach = player.getRadius() + shipStep + obstacleStep;
+      candidates.clear();
+      grid.forEachInRange(player.position, reach + grid.maxRadius,
+                          [&](int i) { candidates.push_back(i); });
+      for (int i : candidates)
+        test(i);
+    } else {
+      for (int i = 0; i < asteroids.size(); i++)
+        test(i);
+    }
+    if (hit < 0)
+      return false;
+
+    sf::Vector2f contact = hitStart + hitMotion * hitToi;
+    float distance = std::sqrt(contact.x * contact.x + contact.y * contact.y);
+    sf::Vector2f normal = contact / distance;
+
+    sf::Vector2f before = asteroids.velocity(hit);
+    applyShipImpact(player, asteroids, hit, normal);
+    recordShipImpact(hit, before);
+
+    // Remaining fraction of the step, relative to the obstacle's end pose
+    sf::Vector2f rest =
+        (player.velocity - asteroids.velocity(hit)) * (dt * (1.0f - hitToi));
+    player.position = asteroids.position(hit) + contact + rest;
+    player.wrapPosition();
+    return true;
+  }
+
+  // Keeps the strongest impacts, replacing the weakest once full
+  void recordImpactEvents() {
+    const ObstacleSolver &solver = obstacleSolver;
+    for (size_t p = 0; p < solver.pairs.size(); p++) {
+      float impulse = solver.pairImpulse[p];
+      if (impulse < AUDIO_IMPACT_MIN_IMPULSE)
+        continue;
+      int a = solver.pairs[p].first;
+      int b = solver.pairs[p].second;
+      // Where the surfaces meet, across the seam if need be
+      float share =
+          asteroids.radius[a] / (asteroids.radius[a] + asteroids.radius[b]);
+      sf::Vector2f contact = {
+          asteroids.x[a] +
+              wrapDelta(asteroids.x[b] - asteroids.x[a], tuning.worldWidth) *
+                  share,
+          asteroids.y[a] +
+              wrapDelta(asteroids.y[b] - asteroids.y[a], tuning.worldHeight) *
+                  share};
+      if (impactEvents.size() < AUDIO_IMPACT_EVENTS) {
+        impactEvents.push_back({contact, impulse});
+        continue;
+      }
+      auto weakest = std::min_element(
+          impactEvents.begin(), impactEvents.end(),
+          [](const ImpactEvent &l, const ImpactEvent &r) {
+            return l.impulse < r.impulse;
+          });
+      if (weakest->impulse < impulse)
+        *weakest = {contact, impulse};
+    }
+  }
+
+  bool solverUsesGrid() const {
+    return useBroadPhase && asteroids.size() >= GRID_MIN_OBSTACLES;
+  }
+
+  // Steps that run the solver on the grid rebuild it anyway
+  bool shipUsesGrid() const {
+    return resolveObstacleContacts && solverUsesGrid();
+  }
+
+  // Resolves ship-vs-asteroid contacts; returns how many were hit
+  int collideShip() {
+    int collisions = 0;
+    if (shipUsesGrid()) {
+      // The sweep may already have built the grid this step
+      if (!gridFresh)
+        grid.rebuild(asteroids);
+      gridFresh = false;
+
+      // The query is padded by the ship radius; if overlap push-out carries
+      // the ship further than that, re-query and continue after the current
+      // index so resolution order matches the brute-force sweep exactly
+      float pad = player.getRadius();
+      sf::Vector2f queryCenter = player.getPosition();
+      grid.query(queryCenter, player.getRadius() + pad, asteroids, candidates);
+      for (size_t k = 0; k < candidates.size(); k++) {
+        int idx = candidates[k];
+        if (!collideWith(idx))
+          continue;
+        collisions++;
+
+        sf::Vector2f drift = player.getPosition() - queryCenter;
+        if (drift.x * drift.x + drift.y * drift.y > pad * pad) {
+          queryCenter = player.getPosition();
+          grid.query(queryCenter, player.getRadius() + pad, asteroids,
+                     candidates);
+          k = std::upper_bound(candidates.begin(), candidates.end(), idx) -
+              candidates.begin() - 1;
+        }
+      }
+    } else {
+      for (int i = 0; i < asteroids.size(); i++) {
+        if (collideWith(i))
+          collisions++;
+      }
+    }
+    return collisions;
+  }
+
+  bool collideWith(int i) {
+    sf::Vector2f before = asteroids.velocity(i);
+    if (!handleCollision(player, asteroids, i))
+      return false;
+    recordShipImpact(i, before);
+    return true;
+  }
+
+  // Impulse an asteroid took from the ship: its mass times velocity change
+  void recordShipImpact(int i, sf::Vector2f before) {
+    sf::Vector2f change = asteroids.velocity(i) - before;
+    fragmenter.recordImpact(i, std::hypot(change.x, change.y) /
+                                   asteroids.invMass[i]);
+  }
+};
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef WORLDRENDERER_HPP
+#define WORLDRENDERER_HPP
+
+#include "Astronaut.hpp"
+#include "Config.hpp"
+#include "Constants.h"
+#include "Goal.hpp"
+#include "RenderSnapshot.hpp"
+#include "TextureCache.hpp"
+#include "ThrusterPlume.hpp"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Owns every texture and sprite needed to draw a World. Sprites are only
+// positioned at draw time, from a RenderSnapshot of the simulation.
+class WorldRenderer {
+public:
+  // Every texture is owned by the cache; the renderer only holds pointers
+  TextureCache textures;
+  const sf::Texture *backgroundTexture = nullptr;
+  const sf::Texture *texHealthy = nullptr;
+  const sf::Texture *texDamaged = nullptr;
+  const sf::Texture *texBroken = nullptr;
+  const sf::Texture *wormholeTexture = nullptr;
+  // All asteroid variants share one atlas and are drawn as one vertex array
+  const TextureAtlas *asteroidAtlas = nullptr;
+  sf::VertexArray asteroidVertices{sf::PrimitiveType::Triangles};
+
+  std::unique_ptr<sf::Sprite> background;
+  std::unique_ptr<sf::Sprite> shipSprite;
+  std::unique_ptr<sf::Sprite> wormholeSprite;
+
+  int shipTextureState = 0; // Texture currently bound to shipSprite
+  bool ready = false;        // Sprites are built once textures are in
+
+  // World-space camera. It follows the ship when the world is larger than
+  // the window and is fixed on the window otherwise.
+  sf::View camera;
+  int drawnAsteroids = 0; // Survivors of culling in the last draw
+
+  // Exhaust of every ship in one batch; each ship keeps its own flicker
+  ThrusterPlume plumes;
+  ThrusterPlume::Animation playerPlume;
+
+  // Queue every texture for background decoding
+  void requestAssets(AssetLoader &loader) {
+    textures.request(config.asset(TEX_BACKGROUND), loader);
+    textures.request(config.asset(TEX_SHIP_HEALTHY), loader);
+    textures.request(config.asset(TEX_SHIP_DAMAGED), loader);
+    textures.request(config.asset(TEX_SHIP_BROKEN), loader);
+    textures.request(config.asset(TEX_WORMHOLE), loader);
+    textures.requestAtlas("asteroids", asteroidPaths(), loader);
+  }
+
+  // Call once per frame on the GL thread. Uploads whatever has finished
+  // decoding; the background is shown as soon as it arrives. Returns true
+  // when everything is loaded. Without requestAssets it loads synchronously.
+  bool finishLoading() {
+    if (ready)
+      return true;
+    bool allUploaded = textures.upload();
+    if (!background && textures.has(config.asset(TEX_BACKGROUND)))
+      setupBackground();
+    if (!allUploaded)
+      return false;
+    setupSprites();
+    ready = true;
+    return true;
+  }
+
+  static std::vector<std::string> asteroidPaths() {
+    return {config.asset(TEX_ASTEROID_1), config.asset(TEX_ASTEROID_2),
+            config.asset(TEX_ASTEROID_3), config.asset(TEX_ASTEROID_4)};
+  }
+
+  void setupBackground() {
+    backgroundTexture = &textures.get(config.asset(TEX_BACKGROUND));
+    background = std::make_unique<sf::Sprite>(*backgroundTexture);
+    // Scale background to viewport dimensions
+    sf::Vector2u bgSize = backgroundTexture->getSize();
+    background->setScale({static_cast<float>(tuning.windowWidth) / bgSize.x,
+                          static_cast<float>(tuning.windowHeight) / bgSize.y});
+  }
+
+  void setupSprites() {
+    if (!background)
+      setupBackground();
+
+    texHealthy = &textures.get(config.asset(TEX_SHIP_HEALTHY));
+    texDamaged = &textures.get(config.asset(TEX_SHIP_DAMAGED));
+    texBroken = &textures.get(config.asset(TEX_SHIP_BROKEN));
+    shipSprite = std::make_unique<sf::Sprite>(*texHealthy);
+    fitSprite(*shipSprite, *texHealthy, tuning.astroRadius);
+
+    wormholeTexture = &textures.get(config.asset(TEX_WORMHOLE));
+    wormholeSprite = std::make_unique<sf::Sprite>(*wormholeTexture);
+    fitSprite(*wormholeSprite, *wormholeTexture, tuning.goalRadius);
+
+    // Asteroid variants are packed into one atlas
+    asteroidAtlas = &textures.atlas("asteroids", asteroidPaths());
+  }
+
+  // Normalize sprite dimensions to a circle of the given radius
+  static void fitSprite(sf::Sprite &sprite, const sf::Texture &texture,
+                        float radius) {
+    sf::Vector2u texSize = texture.getSize();
+    float scale = (radius * 2.0f) / static_cast<float>(texSize.x);
+    sprite.setScale({scale, scale});
+    sprite.setOrigin({texSize.x / 2.0f, texSize.y / 2.0f});
+  }
+
+  void drawBackground(sf::RenderTarget &target) {
+    if (background)
+      target.draw(*background);
+  }
+
+  static bool followsShip() {
+    return tuning.worldWidth > tuning.windowWidth ||
+           tuning.worldHeight > tuning.windowHeight;
+  }
+
+  static sf::Vector2f cameraCenter(const RenderSnapshot &frame) {
+    if (followsShip())
+      return frame.player.position;
+    return {tuning.windowWidth / 2.0f, tuning.windowHeight / 2.0f};
+  }
+
+  // The copy of a wrapped world position nearest the camera, so objects
+  // across the world seam are drawn next to the ship instead of a world
+  // away
+  static sf::Vector2f nearCamera(sf::Vector2f position, sf::Vector2f center) {
+    return {center.x + wrapDelta(position.x - center.x, tuning.worldWidth),
+            center.y + wrapDelta(position.y - center.y, tuning.worldHeight)};
+  }
+
+  // Window pixel position of a world position, for screen-space overlays
+  static sf::Vector2f screenPosition(const RenderSnapshot &frame,
+                                     sf::Vector2f position) {
+    sf::Vector2f center = cameraCenter(frame);
+    return nearCamera(position, center) - center +
+           sf::Vector2f(tuning.windowWidth / 2.0f, tuning.windowHeight / 2.0f);
+  }
+
+  // The snapshot's poses are already interpolated. The background stays in
+  // screen space; the window is left on its default view for HUD drawing.
+  void draw(sf::RenderTarget &target, const RenderSnapshot &frame) {
+    drawBackground(target);
+    if (!ready)
+      return;
+
+    sf::Vector2f center = cameraCenter(frame);
+    camera.setCenter(center);
+    camera.setSize({static_cast<float>(tuning.windowWidth),
+                    static_cast<float>(tuning.windowHeight)});
+    target.setView(camera);
+
+    wormholeSprite->setPosition(nearCamera(frame.wormhole.position, center));
+    wormholeSprite->setRotation(sf::degrees(frame.wormhole.rotation));
+    target.draw(*wormholeSprite);
+
+    // Visible part of the asteroid field in one draw call
+    buildAsteroidVertices(frame);
+    target.draw(asteroidVertices, sf::RenderStates(&asteroidAtlas->texture));
+
+    sf::Vector2f shipPosition = nearCamera(frame.player.position, center);
+    plumes.clear();
+    plumes.add(frame.player, shipPosition, frame.player.angle, playerPlume);
+    plumes.draw(target);
+    drawAstronaut(target, frame.player, shipPosition, frame.player.angle);
+    target.setView(target.getDefaultView());
+  }
+
+  // Two triangles per asteroid, rotated about its center. The quad spans
+  // 2r across and keeps the source image's aspect, matching fitSprite.
+  // Asteroids outside the camera view are skipped.
+  void buildAsteroidVertices(const RenderSnapshot &frame) {
+    int count = frame.asteroidCount();
+    sf::Vector2f view = cameraCenter(frame);
+    float halfWidth = tuning.windowWidth / 2.0f;
+    float halfHeight = tuning.windowHeight / 2.0f;
+    asteroidVertices.resize(static_cast<size_t>(count) * 6);
+    drawnAsteroids = 0;
+    for (int i = 0; i < count; i++) {
+      const sf::IntRect &rect = asteroidAtlas->rects[frame.textureIndex[i]];
+      sf::Vector2f texPos(rect.position);
+      sf::Vector2f texSize(rect.size);
+
+      float hx = frame.radius[i];
+      float hy = hx * texSize.y / texSize.x;
+      float angle = frame.angle[i];
+      sf::Vector2f center = nearCamera({frame.x[i], frame.y[i]}, view);
+      // The rotated quad lies within sqrt(2) * max(hx, hy) of its center
+      float extent = std::max(hx, hy) * CAMERA_CULL_MARGIN;
+      if (std::abs(center.x - view.x) > halfWidth + extent ||
+          std::abs(center.y - view.y) > halfHeight + extent)
+        continue;
+
+      float rad = angle * (3.14159f / 180.0f);
+      float c = std::cos(rad);
+      float s = std::sin(rad);
+
+      // Rotated half-extent axes
+      sf::Vector2f ax(hx * c, hx * s);
+      sf::Vector2f ay(-hy * s, hy * c);
+
+      sf::Vertex corners[4] = {
+          {center - ax - ay, sf::Color::White, texPos},
+          {center + ax - ay, sf::Color::White, texPos + sf::Vector2f(texSize.x, 0.f)},
+          {center + ax + ay, sf::Color::White, texPos + texSize},
+          {center - ax + ay, sf::Color::White, texPos + sf::Vector2f(0.f, texSize.y)}};
+
+      sf::Vertex *quad =
+          &asteroidVertices[static_cast<size_t>(drawnAsteroids++) * 6];
+      quad[0] = corners[0];
+      quad[1] = corners[1];
+      quad[2] = corners[2];
+      quad[3] = corners[0];
+      quad[4] = corners[2];
+      quad[5] = corners[3];
+    }
+    asteroidVertices.resize(static_cast<size_t>(drawnAsteroids) * 6);
+  }
+
+  void drawAstronaut(sf::RenderTarget &target, const Astronaut &player,
+                     sf::Vector2f position, float angle) {
+    // Texture switching driven by the simulated hull state
+    if (player.currentShipState != shipTextureState) {
+      shipTextureState = player.currentShipState;
+      const sf::Texture &texture = shipTextureState == 0   ? *texHealthy
+                                   : shipTextureState == 1 ? *texDamaged
+                                                           : *texBroken;
+      shipSprite->setTexture(texture);
+      // Re-center origin for geometric consistency
+      fitSprite(*shipSprite, texture, tuning.astroRadius);
+    }
+
+    shipSprite->setPosition(position);
+    // Align sprite orientation with thrust vector
+    shipSprite->setRotation(sf::degrees(angle + 180.0f));
+    target.draw(*shipSprite);
+  }
+};
+
+#endif
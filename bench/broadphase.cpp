@@ -0,0 +1,75 @@
+#include "Config.hpp"
+#include "Constants.h"
+#include "World.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+// Tick time versus obstacle count for the brute-force and grid collision
+// paths: ship contacts plus the asteroid pair search, which is where the
+// grid pays off. (The ship alone tests every asteroid either way, since one
+// query does not repay a rebuild.) The world grows with the count so the
+// field keeps the same density, BODY_AREA square pixels per asteroid, and
+// the whole world is simulated (no chunk streaming). Both runs use the same
+// seed, so their collision counts must match. Brute force is O(n^2) and is
+// skipped above BRUTE_MAX bodies.
+static const float BODY_AREA = 50000.0f;
+static const int BRUTE_MAX = 10000;
+
+struct RunResult {
+  double usPerTick;
+  long collisions;
+};
+
+static RunResult run(int obstacleCount, bool useBroadPhase, int ticks) {
+  // Bodies spawn in the first 80% of each axis
+  Tuning saved = tuning;
+  int side = static_cast<int>(std::sqrt(obstacleCount * BODY_AREA) / 0.8f);
+  tuning.worldWidth = std::max(side, WINDOW_WIDTH);
+  tuning.worldHeight = std::max(side, WINDOW_HEIGHT);
+
+  World world(0, tuning.solverThreads, 1234);
+  world.chunks.enabled = false;
+  world.spawnObstacles(obstacleCount);
+  world.useBroadPhase = useBroadPhase;
+  world.start();
+
+  const float dt = SIM_DT;
+  long collisions = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int tick = 0; tick < ticks; tick++) {
+    PlayerInput input;
+    input.thrust = (tick / SIM_TICK_RATE) % 2 == 0;
+    StepEvents events = world.step(dt, input);
+    collisions += events.collisions + events.obstacleContacts;
+    if (world.gameState != GAME_STATE_PLAYING)
+      world.restart();
+  }
+  auto end = std::chrono::steady_clock::now();
+  tuning = saved;
+  double us = std::chrono::duration<double, std::micro>(end - begin).count();
+  return {us / ticks, collisions};
+}
+
+int main() {
+  const int counts[] = {10, 100, 1000, 10000, 100000};
+
+  std::printf("%10s %14s %14s %9s %12s\n", "obstacles", "brute us/tick",
+              "grid us/tick", "speedup", "collisions");
+  for (int count : counts) {
+    // Keep total work roughly constant across sizes
+    int ticks = count >= 10000 ? 50 : 2000;
+    RunResult grid = run(count, true, ticks);
+    if (count > BRUTE_MAX) {
+      std::printf("%10d %14s %14.2f %9s %12ld\n", count, "-", grid.usPerTick,
+                  "-", grid.collisions);
+      continue;
+    }
+    RunResult brute = run(count, false, ticks);
+    std::printf("%10d %14.2f %14.2f %8.1fx %12ld%s\n", count, brute.usPerTick,
+                grid.usPerTick, brute.usPerTick / grid.usPerTick,
+                grid.collisions,
+                brute.collisions == grid.collisions ? "" : "  MISMATCH");
+  }
+  return 0;
+}
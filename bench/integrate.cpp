@@ -0,0 +1,138 @@
+#include "Constants.h"
+#include "IntegrateKernel.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Integrate-and-wrap micro-benchmark: the original per-object update
+// (array of structs, branchy wraps) against the scalar and SIMD kernels over
+// packed columns. Every kernel's output is compared bit-for-bit against the
+// scalar kernel.
+
+// Layout and update of the pre-SoA Obstacle, minus the sprite
+struct LegacyObstacle {
+  float x, y, vx, vy, rotation, angularVelocity, radius, mass;
+  int textureIndex;
+
+  void update(float dt) {
+    x += vx * dt;
+    y += vy * dt;
+    rotation += angularVelocity * dt;
+    if (rotation >= 360.f)
+      rotation -= 360.f;
+    if (rotation < 0.f)
+      rotation += 360.f;
+    if (x < 0)
+      x = WINDOW_WIDTH;
+    if (x > WINDOW_WIDTH)
+      x = 0;
+    if (y < 0)
+      y = WINDOW_HEIGHT;
+    if (y > WINDOW_HEIGHT)
+      y = 0;
+  }
+};
+
+struct Columns {
+  std::vector<float> x, y, angle, vx, vy, omega;
+
+  explicit Columns(int n)
+      : x(n), y(n), angle(n), vx(n), vy(n), omega(n) {
+    std::srand(42);
+    for (int i = 0; i < n; i++) {
+      x[i] = static_cast<float>(std::rand() % WINDOW_WIDTH);
+      y[i] = static_cast<float>(std::rand() % WINDOW_HEIGHT);
+      angle[i] = static_cast<float>(std::rand() % 360);
+      // Fast enough that bodies cross the seams during the run
+      vx[i] = static_cast<float>(std::rand() % 2000 - 1000);
+      vy[i] = static_cast<float>(std::rand() % 2000 - 1000);
+      omega[i] = static_cast<float>(std::rand() % 720 - 360);
+    }
+  }
+
+  IntegrateArgs args(float dt) {
+    return {x.data(),  y.data(),  angle.data(),
+            vx.data(), vy.data(), omega.data(),
+            static_cast<int>(x.size()), dt,
+            static_cast<float>(WINDOW_WIDTH),
+            static_cast<float>(WINDOW_HEIGHT)};
+  }
+
+  bool sameAs(const Columns &o) const {
+    size_t bytes = x.size() * sizeof(float);
+    return std::memcmp(x.data(), o.x.data(), bytes) == 0 &&
+           std::memcmp(y.data(), o.y.data(), bytes) == 0 &&
+           std::memcmp(angle.data(), o.angle.data(), bytes) == 0;
+  }
+};
+
+template <typename Fn> static double nsPerBody(int n, int reps, Fn &&fn) {
+  fn(); // Warm-up
+  auto begin = std::chrono::steady_clock::now();
+  for (int r = 0; r < reps; r++)
+    fn();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count() /
+         (static_cast<double>(reps) * n);
+}
+
+int main() {
+  const int counts[] = {1000, 100000, 1000000};
+  const float dt = SIM_DT;
+
+  struct Variant {
+    const char *name;
+    IntegrateFn fn;
+  };
+  std::vector<Variant> variants = {{"scalar", integrateScalar}};
+#if INTEGRATE_KERNEL_X86
+  variants.push_back({"sse2", integrateSSE2});
+  if (__builtin_cpu_supports("avx2"))
+    variants.push_back({"avx2", integrateAVX2});
+#elif INTEGRATE_KERNEL_NEON
+  variants.push_back({"neon", integrateNEON});
+#endif
+
+  std::printf("dispatch selects: %s\n\n",
+              integrateKernelName(selectIntegrateKernel()));
+  std::printf("%10s %-12s %10s %9s\n", "bodies", "path", "ns/body",
+              "speedup");
+
+  for (int n : counts) {
+    int reps = static_cast<int>(200000000LL / n / 10);
+    if (reps < 20)
+      reps = 20;
+
+    std::vector<LegacyObstacle> legacy(n);
+    Columns seed(n);
+    for (int i = 0; i < n; i++)
+      legacy[i] = {seed.x[i],     seed.y[i],     seed.vx[i], seed.vy[i],
+                   seed.angle[i], seed.omega[i], 30.f,       90.f,
+                   i % NUM_ASTEROID_TEXTURES};
+    double base = nsPerBody(n, reps, [&] {
+      for (auto &o : legacy)
+        o.update(dt);
+    });
+    std::printf("%10d %-12s %10.3f %8.1fx\n", n, "per-object", base, 1.0);
+
+    // Reference output for bit-exact comparison
+    Columns reference(n);
+    for (int r = 0; r < 8; r++)
+      integrateScalar(reference.args(dt));
+
+    for (const Variant &v : variants) {
+      Columns check(n);
+      for (int r = 0; r < 8; r++)
+        v.fn(check.args(dt));
+
+      Columns cols(n);
+      IntegrateArgs args = cols.args(dt);
+      double ns = nsPerBody(n, reps, [&] { v.fn(args); });
+      std::printf("%10d %-12s %10.3f %8.1fx%s\n", n, v.name, ns, base / ns,
+                  check.sameAs(reference) ? "" : "  MISMATCH");
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,334 @@
+#include "Astronaut.hpp"
+#include "Collision.hpp"
+#include "Config.hpp"
+#include "Constants.h"
+#include "Goal.hpp"
+#include "HUD.hpp"
+#include "ObstacleField.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Micro-benchmarks for the per-body hot paths: ship-asteroid collision
+// (hit and miss), Astronaut::update, the obstacle integrate pass, the goal
+// test and HUD::update, each over several body counts. Every case is
+// warmed up, then timed as a number of samples whose length is calibrated
+// to at least SAMPLE_MIN_US; the summary is ns per body (min, median,
+// mean, standard deviation). No window or GPU is needed.
+//
+//   bench_micro                      table only
+//   bench_micro --csv FILE           also write results as CSV
+//   bench_micro --compare FILE       flag medians slower than the baseline
+//               [--threshold PCT]    by more than PCT percent (default 10);
+//                                    exits with 1 on any regression
+//   bench_micro --filter TEXT        only cases whose name contains TEXT
+//   bench_micro --samples N          timed samples per case (default 25)
+
+static const int WARMUP_SAMPLES = 3;
+static const double SAMPLE_MIN_US = 2000.0;
+static const int BODY_COUNTS[] = {16, 256, 4096};
+
+// One case at one body count: setup builds fresh state, pass runs the
+// operation once per body
+struct Case {
+  std::string name;
+  std::function<void(int)> setup;
+  std::function<void()> pass;
+};
+
+struct Summary {
+  double min, median, mean, stddev; // ns per body
+};
+
+static Summary measure(Case &c, int bodies, int samples) {
+  c.setup(bodies);
+  using Clock = std::chrono::steady_clock;
+  auto timePasses = [&c](long passes) {
+    auto begin = Clock::now();
+    for (long p = 0; p < passes; p++)
+      c.pass();
+    return std::chrono::duration<double, std::micro>(Clock::now() - begin)
+        .count();
+  };
+
+  // Calibrate passes per sample, which also warms caches and predictors
+  long passes = 1;
+  while (timePasses(passes) < SAMPLE_MIN_US)
+    passes *= 2;
+  for (int w = 0; w < WARMUP_SAMPLES; w++)
+    timePasses(passes);
+
+  std::vector<double> ns(samples);
+  for (double &sample : ns)
+    sample = timePasses(passes) * 1000.0 / (static_cast<double>(passes) *
+                                            bodies);
+  std::sort(ns.begin(), ns.end());
+  Summary s;
+  s.min = ns.front();
+  s.median = ns[ns.size() / 2];
+  double sum = 0.0;
+  for (double v : ns)
+    sum += v;
+  s.mean = sum / ns.size();
+  double var = 0.0;
+  for (double v : ns)
+    var += (v - s.mean) * (v - s.mean);
+  s.stddev = std::sqrt(var / ns.size());
+  return s;
+}
+
+// Keeps results observable so passes are not optimized away
+static volatile float sink;
+
+static std::vector<Case> makeCases() {
+  std::vector<Case> cases;
+
+  // Shared state, rebuilt by each setup
+  auto field = std::make_shared<ObstacleField>();
+  auto ships = std::make_shared<std::vector<Astronaut>>();
+  auto offsets = std::make_shared<std::vector<sf::Vector2f>>();
+  auto velocities = std::make_shared<std::vector<float>>();
+
+  auto spawn = [field, velocities](int n) {
+    field->clear();
+    field->reserve(n);
+    std::srand(42);
+    for (int i = 0; i < n; i++) {
+      float x = static_cast<float>(std::rand() % tuning.worldWidth);
+      float y = static_cast<float>(std::rand() % tuning.worldHeight);
+      float vx = static_cast<float>(std::rand() % 100 - 50);
+      float vy = static_cast<float>(std::rand() % 100 - 50);
+      float r = static_cast<float>(std::rand() % tuning.maxObstacleRadius +
+                                   tuning.minObstacleRadius);
+      float spin = static_cast<float>(std::rand() % 120 - 60);
+      field->add(i % NUM_ASTEROID_TEXTURES, {x, y}, {vx, vy}, r, spin);
+    }
+    velocities->assign(field->vx.begin(), field->vx.end());
+    velocities->insert(velocities->end(), field->vy.begin(), field->vy.end());
+  };
+
+  // Ship overlapping each asteroid in turn. Ship pose and the body's
+  // velocity are restored before every call so each one is a fresh hit.
+  auto ship = std::make_shared<Astronaut>();
+  cases.push_back(
+      {"collision_hit",
+       [spawn, offsets](int n) {
+         spawn(n);
+         offsets->resize(n);
+         for (int i = 0; i < n; i++) {
+           float a = i * 0.7f;
+           (*offsets)[i] = {std::cos(a) * 20.0f, std::sin(a) * 20.0f};
+         }
+       },
+       [field, ship, offsets, velocities] {
+         int n = field->size();
+         int hits = 0;
+         for (int i = 0; i < n; i++) {
+           ship->position = field->position(i) + (*offsets)[i];
+           ship->velocity = {30.0f, -20.0f};
+           ship->angularVelocity = 90.0f;
+           field->vx[i] = (*velocities)[i];
+           field->vy[i] = (*velocities)[n + i];
+           hits += handleCollision(*ship, *field, i);
+         }
+         sink = static_cast<float>(hits);
+       }});
+
+  // Ship far from every asteroid: the early-out path
+  cases.push_back({"collision_miss",
+                   [spawn, field, ship](int n) {
+                     spawn(n);
+                     // Pack the field into one corner, ship in the other
+                     for (int i = 0; i < n; i++) {
+                       field->x[i] = std::fmod(field->x[i], 200.0f);
+                       field->y[i] = std::fmod(field->y[i], 200.0f);
+                     }
+                     ship->position = {tuning.worldWidth - 100.0f,
+                                       tuning.worldHeight - 100.0f};
+                   },
+                   [field, ship] {
+                     int hits = 0;
+                     for (int i = 0; i < field->size(); i++)
+                       hits += handleCollision(*ship, *field, i);
+                     sink = static_cast<float>(hits);
+                   }});
+
+  // Independent ships, half thrusting; drains are off so none dies or
+  // runs dry and the work per call stays constant
+  cases.push_back({"astronaut_update",
+                   [ships](int n) {
+                     ships->assign(n, Astronaut());
+                     for (int i = 0; i < n; i++) {
+                       Astronaut &a = (*ships)[i];
+                       a.oxygenDrainRate = 0.0f;
+                       a.thrustDrainRate = 0.0f;
+                       a.angularVelocity = 50.0f + i % 100;
+                       a.velocity = {static_cast<float>(i % 7),
+                                     static_cast<float>(i % 5)};
+                     }
+                   },
+                   [ships] {
+                     int i = 0;
+                     for (Astronaut &a : *ships)
+                       a.update(SIM_DT, (i++ & 1) != 0);
+                     sink = ships->front().position.x;
+                   }});
+
+  // The field-wide integrate-and-wrap pass that replaced the per-object
+  // Obstacle::update
+  cases.push_back({"obstacle_integrate", [spawn](int n) { spawn(n); },
+                   [field] {
+                     field->integrate(SIM_DT);
+                     sink = field->x[0];
+                   }});
+
+  // Goal test against a spread of ship positions, about half inside
+  auto goal = std::make_shared<Goal>();
+  cases.push_back(
+      {"goal_check",
+       [goal, offsets](int n) {
+         offsets->resize(n);
+         for (int i = 0; i < n; i++) {
+           float a = i * 0.7f;
+           float d = (i & 1) ? 30.0f : 300.0f;
+           (*offsets)[i] = goal->position +
+                           sf::Vector2f(std::cos(a) * d, std::sin(a) * d);
+         }
+       },
+       [goal, offsets] {
+         int reached = 0;
+         for (const sf::Vector2f &p : *offsets) {
+           goal->reset();
+           goal->checkCollision(p, tuning.astroRadius);
+           reached += goal->isReached;
+         }
+         sink = static_cast<float>(reached);
+       }});
+
+  // Bar geometry from ship state; one HUD, n different ships
+  auto hud = std::make_shared<HUD>();
+  cases.push_back({"hud_update",
+                   [ships, offsets](int n) {
+                     ships->assign(n, Astronaut());
+                     offsets->resize(n);
+                     for (int i = 0; i < n; i++) {
+                       (*ships)[i].oxygen = static_cast<float>(i % 100);
+                       (*ships)[i].thrustCapacity =
+                           static_cast<float>((i * 7) % 100);
+                       (*offsets)[i] = {static_cast<float>(i % 1000),
+                                        static_cast<float>(i % 700)};
+                     }
+                   },
+                   [hud, ships, offsets] {
+                     for (size_t i = 0; i < ships->size(); i++)
+                       hud->update((*ships)[i], (*offsets)[i]);
+                   }});
+  return cases;
+}
+
+using Key = std::pair<std::string, int>;
+
+// CSV written by --csv: case,bodies,min_ns,median_ns,mean_ns,stddev_ns
+static std::map<Key, double> loadBaseline(const char *path) {
+  std::map<Key, double> medians;
+  std::ifstream in(path);
+  std::string line;
+  std::getline(in, line); // Header
+  while (std::getline(in, line)) {
+    std::stringstream row(line);
+    std::string name, bodies, min, median;
+    if (std::getline(row, name, ',') && std::getline(row, bodies, ',') &&
+        std::getline(row, min, ',') && std::getline(row, median, ','))
+      medians[{name, std::atoi(bodies.c_str())}] = std::atof(median.c_str());
+  }
+  return medians;
+}
+
+int main(int argc, char *argv[]) {
+  const char *csvPath = nullptr;
+  const char *baselinePath = nullptr;
+  const char *filter = "";
+  double threshold = 10.0;
+  int samples = 25;
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--csv") && hasValue)
+      csvPath = argv[++i];
+    else if (!std::strcmp(argv[i], "--compare") && hasValue)
+      baselinePath = argv[++i];
+    else if (!std::strcmp(argv[i], "--threshold") && hasValue)
+      threshold = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--filter") && hasValue)
+      filter = argv[++i];
+    else if (!std::strcmp(argv[i], "--samples") && hasValue)
+      samples = std::max(1, std::atoi(argv[++i]));
+    else {
+      std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  std::map<Key, double> baseline;
+  if (baselinePath) {
+    baseline = loadBaseline(baselinePath);
+    if (baseline.empty()) {
+      std::fprintf(stderr, "No baseline results in %s\n", baselinePath);
+      return 2;
+    }
+  }
+  std::ofstream csv;
+  if (csvPath) {
+    csv.open(csvPath);
+    csv << "case,bodies,min_ns,median_ns,mean_ns,stddev_ns\n";
+  }
+
+  std::printf("%-20s %7s %9s %9s %9s %8s", "case", "bodies", "min ns",
+              "median ns", "mean ns", "stddev");
+  if (baselinePath)
+    std::printf(" %9s %8s", "base ns", "change");
+  std::printf("\n");
+
+  int regressions = 0;
+  for (Case &c : makeCases()) {
+    if (c.name.find(filter) == std::string::npos)
+      continue;
+    for (int bodies : BODY_COUNTS) {
+      Summary s = measure(c, bodies, samples);
+      std::printf("%-20s %7d %9.3f %9.3f %9.3f %8.3f", c.name.c_str(), bodies,
+                  s.min, s.median, s.mean, s.stddev);
+      if (csv.is_open())
+        csv << c.name << "," << bodies << "," << s.min << "," << s.median
+            << "," << s.mean << "," << s.stddev << "\n";
+      if (baselinePath) {
+        auto it = baseline.find({c.name, bodies});
+        if (it == baseline.end() || it->second <= 0.0) {
+          std::printf(" %9s %8s", "-", "new");
+        } else {
+          double change = 100.0 * (s.median / it->second - 1.0);
+          bool regressed = change > threshold;
+          regressions += regressed;
+          std::printf(" %9.3f %+7.1f%%%s", it->second, change,
+                      regressed ? "  REGRESSION" : "");
+        }
+      }
+      std::printf("\n");
+    }
+  }
+
+  if (baselinePath) {
+    std::printf("\n%d regression(s) beyond %.1f%%\n", regressions, threshold);
+    return regressions > 0 ? 1 : 0;
+  }
+  return 0;
+}
@@ -0,0 +1,130 @@
+#include "Constants.h"
+#include "World.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Spawn/despawn churn against the pooled ObstacleField. Every tick the
+// oldest bodies are removed by handle and as many new ones are added, then
+// the world is stepped. Heap allocations are counted through the global
+// operator new; after warm-up a steady-state tick must make none. The
+// pre-pool layout (one heap-allocated sprite per obstacle, pushed into an
+// unreserved vector and erased) is run with the same churn for comparison.
+
+static long allocations = 0;
+
+void *operator new(std::size_t size) {
+  allocations++;
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+// Layout of the pre-SoA Obstacle; the sprite stands in for sf::Sprite
+struct LegacyObstacle {
+  struct Sprite {
+    float transform[16];
+    int textureRect[4];
+  };
+  float x, y, vx, vy, rotation, angularVelocity, radius, mass;
+  std::unique_ptr<Sprite> sprite;
+
+  LegacyObstacle(float x, float y, float vx, float vy, float r)
+      : x(x), y(y), vx(vx), vy(vy), rotation(0.f), angularVelocity(0.f),
+        radius(r), mass(r * r * OBSTACLE_MASS_SCALE),
+        sprite(std::make_unique<Sprite>()) {}
+};
+
+struct RunResult {
+  double usPerTick;
+  double allocsPerTick;
+  long growths;
+};
+
+static RunResult runPool(int count, int churn, int ticks, int warmup) {
+  World world(count, 1, 1234);
+  world.start();
+  // Ring of live handles; the slot at `oldest` is replaced next
+  std::vector<ObstacleHandle> order;
+  for (int i = 0; i < world.asteroids.size(); i++)
+    order.push_back(world.asteroids.handle(i));
+  size_t oldest = 0;
+
+  Rng rng(99);
+  long allocsBefore = 0;
+  long growthsBefore = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int tick = 0; tick < warmup + ticks; tick++) {
+    if (tick == warmup) {
+      allocsBefore = allocations;
+      growthsBefore = world.asteroids.stats.growths;
+      begin = std::chrono::steady_clock::now();
+    }
+    for (int k = 0; k < churn; k++) {
+      world.asteroids.remove(order[oldest]);
+      float px = static_cast<float>(rng.below(tuning.worldWidth));
+      float py = static_cast<float>(rng.below(tuning.worldHeight));
+      int i = world.asteroids.add(k % NUM_ASTEROID_TEXTURES, {px, py},
+                                  {10.f, -10.f}, 20.f, 30.f);
+      order[oldest] = world.asteroids.handle(i);
+      oldest = (oldest + 1) % order.size();
+    }
+    PlayerInput input;
+    input.thrust = (tick / SIM_TICK_RATE) % 2 == 0;
+    world.tick(input);
+    if (world.gameState != GAME_STATE_PLAYING)
+      world.restart();
+  }
+  auto end = std::chrono::steady_clock::now();
+  double us = std::chrono::duration<double, std::micro>(end - begin).count();
+  return {us / ticks, static_cast<double>(allocations - allocsBefore) / ticks,
+          world.asteroids.stats.growths - growthsBefore};
+}
+
+static RunResult runLegacy(int count, int churn, int ticks) {
+  Rng rng(99);
+  std::vector<LegacyObstacle> asteroids;
+  for (int i = 0; i < count; i++)
+    asteroids.push_back(LegacyObstacle(0.f, 0.f, 1.f, 1.f, 20.f));
+
+  long allocsBefore = allocations;
+  auto begin = std::chrono::steady_clock::now();
+  for (int tick = 0; tick < ticks; tick++) {
+    for (int k = 0; k < churn; k++) {
+      asteroids.erase(asteroids.begin());
+      float px = static_cast<float>(rng.below(tuning.worldWidth));
+      float py = static_cast<float>(rng.below(tuning.worldHeight));
+      asteroids.push_back(LegacyObstacle(px, py, 10.f, -10.f, 20.f));
+    }
+    for (LegacyObstacle &o : asteroids) {
+      o.x += o.vx * SIM_DT;
+      o.y += o.vy * SIM_DT;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  double us = std::chrono::duration<double, std::micro>(end - begin).count();
+  return {us / ticks,
+          static_cast<double>(allocations - allocsBefore) / ticks, 0};
+}
+
+int main() {
+  const int counts[] = {100, 1000, 10000};
+
+  std::printf("%10s %6s %16s %16s %14s %7s\n", "obstacles", "churn",
+              "legacy allocs", "pool allocs", "pool us/tick", "growths");
+  for (int count : counts) {
+    int churn = count / 20; // 5% of the field replaced every tick
+    int ticks = count >= 10000 ? 200 : 1000;
+    RunResult legacy = runLegacy(count, churn, ticks);
+    RunResult pool = runPool(count, churn, ticks, SIM_TICK_RATE);
+    std::printf("%10d %6d %16.1f %16.1f %14.2f %7ld%s\n", count, churn,
+                legacy.allocsPerTick, pool.allocsPerTick, pool.usPerTick,
+                pool.growths, pool.allocsPerTick == 0.0 ? "" : "  ALLOCATES");
+  }
+  return 0;
+}
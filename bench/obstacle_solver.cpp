@@ -0,0 +1,63 @@
+#include "Constants.h"
+#include "World.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+// Asteroid-vs-asteroid solver scaling across thread counts. Every run of a
+// given size must end in the same state; World::stateHash is printed and
+// compared against the single-threaded run.
+struct RunResult {
+  double usPerTick;
+  long contacts;
+  std::uint64_t hash;
+};
+
+static RunResult run(int obstacleCount, int threads, bool useGrid, int ticks) {
+  World world(obstacleCount, threads, 1234);
+  world.useBroadPhase = useGrid;
+  world.start();
+
+  const float dt = SIM_DT;
+  long contacts = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int tick = 0; tick < ticks; tick++) {
+    PlayerInput input;
+    input.thrust = (tick / SIM_TICK_RATE) % 2 == 0;
+    contacts += world.step(dt, input).obstacleContacts;
+    if (world.gameState != GAME_STATE_PLAYING)
+      world.restart();
+  }
+  auto end = std::chrono::steady_clock::now();
+  double us = std::chrono::duration<double, std::micro>(end - begin).count();
+  return {us / ticks, contacts, world.stateHash()};
+}
+
+int main() {
+  const int counts[] = {100, 1000, 5000};
+  int hw = static_cast<int>(std::thread::hardware_concurrency());
+  const int threadCounts[] = {1, 2, 4, hw > 4 ? hw : 8};
+
+  std::printf("%10s %8s %8s %12s %12s %18s\n", "obstacles", "path", "threads",
+              "us/tick", "contacts", "state hash");
+  for (int count : counts) {
+    int ticks = count >= 5000 ? 100 : 600;
+    RunResult reference = run(count, 1, true, ticks);
+    for (int threads : threadCounts) {
+      RunResult r = threads == 1 ? reference : run(count, threads, true, ticks);
+      std::printf("%10d %8s %8d %12.2f %12ld %18llx%s\n", count, "grid",
+                  threads, r.usPerTick, r.contacts,
+                  static_cast<unsigned long long>(r.hash),
+                  r.hash == reference.hash ? "" : "  MISMATCH");
+    }
+    if (count <= 1000) {
+      RunResult brute = run(count, 1, false, ticks);
+      std::printf("%10d %8s %8d %12.2f %12ld %18llx%s\n", count, "brute", 1,
+                  brute.usPerTick, brute.contacts,
+                  static_cast<unsigned long long>(brute.hash),
+                  brute.hash == reference.hash ? "" : "  MISMATCH");
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,122 @@
+#include "Constants.h"
+#include "SimulationThread.hpp"
+#include "World.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Frame time with update and draw back-to-back vs pipelined on the
+// simulation thread, over a large asteroid field at 60 fps of game time.
+// The draw side is a stand-in for WorldRenderer's CPU work: cull and build
+// six textured vertices per visible asteroid from the snapshot. With two
+// or more cores the pipelined frame should approach max(update, draw)
+// instead of their sum. Both runs see the same inputs, so the final state
+// hashes must match.
+
+struct Vertex {
+  float x, y, u, v;
+};
+
+static std::vector<Vertex> vertices;
+
+static int drawProxy(const RenderSnapshot &frame) {
+  int count = frame.asteroidCount();
+  vertices.resize(static_cast<size_t>(count) * 6);
+  // The world fits the window, so the camera does not follow the ship
+  sf::Vector2f view(tuning.windowWidth / 2.0f, tuning.windowHeight / 2.0f);
+  float halfWidth = tuning.windowWidth / 2.0f;
+  float halfHeight = tuning.windowHeight / 2.0f;
+  int drawn = 0;
+  for (int i = 0; i < count; i++) {
+    float hx = frame.radius[i];
+    float cx = view.x + wrapDelta(frame.x[i] - view.x, tuning.worldWidth);
+    float cy = view.y + wrapDelta(frame.y[i] - view.y, tuning.worldHeight);
+    float extent = hx * CAMERA_CULL_MARGIN;
+    if (std::abs(cx - view.x) > halfWidth + extent ||
+        std::abs(cy - view.y) > halfHeight + extent)
+      continue;
+    float rad = frame.angle[i] * (3.14159f / 180.0f);
+    float c = std::cos(rad) * hx;
+    float s = std::sin(rad) * hx;
+    float u = static_cast<float>(frame.textureIndex[i]);
+    Vertex corners[4] = {{cx - c + s, cy - s - c, u, 0.f},
+                         {cx + c + s, cy + s - c, u + 1.f, 0.f},
+                         {cx + c - s, cy + s + c, u + 1.f, 1.f},
+                         {cx - c - s, cy - s + c, u, 1.f}};
+    Vertex *quad = &vertices[static_cast<size_t>(drawn++) * 6];
+    quad[0] = corners[0];
+    quad[1] = corners[1];
+    quad[2] = corners[2];
+    quad[3] = corners[0];
+    quad[4] = corners[2];
+    quad[5] = corners[3];
+  }
+  return drawn;
+}
+
+struct RunResult {
+  double avg, p99; // us per frame
+  long drawn;
+  std::uint64_t hash;
+};
+
+static RunResult run(int count, bool threaded, int frames) {
+  World world(count, 1, 4321);
+  world.start();
+  std::vector<double> times;
+  times.reserve(frames);
+  RunResult result{0, 0, 0, 0};
+  {
+    SimulationThread simulation(world, threaded);
+    FrameInput input;
+    input.dt = 1.0f / FRAMERATE_LIMIT;
+    for (int f = 0; f < frames; f++) {
+      input.input.thrust = (f / 30) % 2 == 0;
+      auto begin = std::chrono::steady_clock::now();
+      const RenderSnapshot &frame = simulation.exchange(input);
+      result.drawn += drawProxy(frame);
+      auto end = std::chrono::steady_clock::now();
+      times.push_back(
+          std::chrono::duration<double, std::micro>(end - begin).count());
+    }
+  }
+  double sum = 0;
+  for (double t : times)
+    sum += t;
+  std::sort(times.begin(), times.end());
+  result.avg = sum / times.size();
+  result.p99 = times[times.size() * 99 / 100];
+  result.hash = world.stateHash();
+  return result;
+}
+
+int main() {
+  const int frames = 10 * FRAMERATE_LIMIT;
+  // Every asteroid on screen, and fragmentation off so the field size is
+  // the same every frame
+  tuning.worldWidth = 4000;
+  tuning.worldHeight = 3000;
+  tuning.windowWidth = 4000;
+  tuning.windowHeight = 3000;
+  tuning.oxygenDrainNormal = 0.0f;
+  tuning.oxygenDrainCollision = 0.0f;
+  tuning.fragmentImpulse = 0.0f;
+
+  std::printf("%-10s %-10s %10s %10s %12s %16s\n", "asteroids", "mode",
+              "avg us", "p99 us", "drawn/frame", "final hash");
+  for (int count : {1000, 2000, 5000}) {
+    std::uint64_t reference = 0;
+    for (bool threaded : {false, true}) {
+      RunResult r = run(count, threaded, frames);
+      if (!threaded)
+        reference = r.hash;
+      std::printf("%-10d %-10s %10.1f %10.1f %12ld %016llx%s\n", count,
+                  threaded ? "pipelined" : "serial", r.avg, r.p99,
+                  r.drawn / frames, static_cast<unsigned long long>(r.hash),
+                  threaded && r.hash != reference ? " MISMATCH" : "");
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,140 @@
+#include "Config.hpp"
+#include "Constants.h"
+#include "UiLayer.hpp"
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+// Per-frame CPU cost of the launch and end screens, immediate (the old
+// main.cpp loop: every text drawn, end-screen text re-laid out each
+// frame) vs retained (UiText/UiLayer). Frames are drawn into an offscreen
+// render texture the size of the window, so no window is opened, but an
+// OpenGL context is still required.
+
+template <typename Frame>
+static double timeFrames(sf::RenderTexture &target, int frames,
+                         const Frame &frame) {
+  for (int f = 0; f < 30; f++) // Warm-up: glyph pages, caches
+    frame(f);
+  auto begin = std::chrono::steady_clock::now();
+  for (int f = 0; f < frames; f++) {
+    target.clear();
+    frame(f);
+    target.display();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - begin).count() /
+         frames;
+}
+
+static void center(sf::Text &text, float x, float y) {
+  sf::FloatRect bounds = text.getLocalBounds();
+  text.setOrigin({bounds.size.x / 2.0f, bounds.size.y / 2.0f});
+  text.setPosition({x, y});
+}
+
+int main() {
+  const int frames = 600;
+  sf::Font font;
+  if (!font.openFromFile(config.asset(FONT_PATH))) {
+    std::cerr << "Cannot load " << config.asset(FONT_PATH) << std::endl;
+    return 1;
+  }
+  sf::RenderTexture target;
+  if (!target.resize({static_cast<unsigned>(tuning.windowWidth),
+                      static_cast<unsigned>(tuning.windowHeight)})) {
+    std::cerr << "Cannot create a render texture" << std::endl;
+    return 1;
+  }
+  const float cx = tuning.windowWidth / 2.0f;
+  const float h = tuning.windowHeight;
+  const char *ruleLines[] = {TEXT_RULE_1, TEXT_RULE_2, TEXT_RULE_3,
+                             TEXT_RULE_4};
+
+  auto pulse = [](int f) {
+    return static_cast<std::uint8_t>(155 + 100 * std::sin(f * 0.066f));
+  };
+
+  // Immediate launch screen: title, instructions and four rules per frame
+  sf::Text title(font, TEXT_GAME_TITLE, TEXT_SIZE_LARGE);
+  title.setOutlineThickness(6.0f);
+  title.setStyle(sf::Text::Bold);
+  center(title, cx, h * 0.25f);
+  sf::Text instructions(font, TEXT_GAME_START_INSTRUCTIONS, TEXT_SIZE_SMALL);
+  instructions.setOutlineThickness(2.5f);
+  center(instructions, cx, h * 0.45f);
+  std::vector<sf::Text> rules;
+  for (int i = 0; i < 4; i++) {
+    rules.emplace_back(font, ruleLines[i], TEXT_SIZE_SMALL);
+    rules.back().setOutlineThickness(1.5f);
+    center(rules.back(), cx, h * (0.60f + 0.05f * i));
+  }
+  double launchBefore = timeFrames(target, frames, [&](int f) {
+    title.setOutlineColor(sf::Color(pulse(f), 0, 255 - pulse(f)));
+    instructions.setFillColor(sf::Color(255, 255, 255, pulse(f)));
+    target.draw(title);
+    target.draw(instructions);
+    for (const sf::Text &rule : rules)
+      target.draw(rule);
+  });
+
+  // Retained launch screen
+  UiText retainedTitle(font, TEXT_GAME_TITLE, TEXT_SIZE_LARGE,
+                       {cx, h * 0.25f});
+  retainedTitle.text.setOutlineThickness(6.0f);
+  retainedTitle.text.setStyle(sf::Text::Bold);
+  UiText retainedInstructions(font, TEXT_GAME_START_INSTRUCTIONS,
+                              TEXT_SIZE_SMALL, {cx, h * 0.45f});
+  retainedInstructions.text.setOutlineThickness(2.5f);
+  UiLayer ruleLayer;
+  for (int i = 0; i < 4; i++)
+    ruleLayer.add(font, ruleLines[i], TEXT_SIZE_SMALL,
+                  {cx, h * (0.60f + 0.05f * i)})
+        .text.setOutlineThickness(1.5f);
+  double launchAfter = timeFrames(target, frames, [&](int f) {
+    sf::Color outline(pulse(f), 0, 255 - pulse(f));
+    retainedTitle.text.setOutlineColor(outline);
+    retainedInstructions.text.setFillColor(
+        sf::Color(255, 255, 255, pulse(f)));
+    retainedTitle.draw(target);
+    retainedInstructions.draw(target);
+    ruleLayer.draw(target);
+  });
+
+  // Immediate end screen: string, bounds, origin and position every frame
+  sf::Text gameOver(font, "", TEXT_SIZE_LARGE);
+  gameOver.setStyle(sf::Text::Bold);
+  sf::Text restart(font, TEXT_RESTART, TEXT_SIZE_SMALL);
+  double endBefore = timeFrames(target, frames, [&](int) {
+    gameOver.setString(TEXT_OXYGEN_DEPLETED);
+    gameOver.setFillColor(sf::Color::Red);
+    center(gameOver, cx, h / 2.0f - 50.0f);
+    center(restart, cx, h / 2.0f + 50.0f);
+    target.draw(gameOver);
+    target.draw(restart);
+  });
+
+  // Retained end screen
+  UiLayer endLayer;
+  endLayer.add(font, TEXT_OXYGEN_DEPLETED, TEXT_SIZE_LARGE,
+               {cx, h / 2.0f - 50.0f})
+      .text.setStyle(sf::Text::Bold);
+  endLayer[0].text.setFillColor(sf::Color::Red);
+  endLayer.add(font, TEXT_RESTART, TEXT_SIZE_SMALL, {cx, h / 2.0f + 50.0f});
+  double endAfter = timeFrames(target, frames, [&](int) {
+    endLayer.draw(target);
+  });
+
+  std::printf("%-8s %12s %12s %9s %9s\n", "screen", "immediate us",
+              "retained us", "layouts", "rebuilds");
+  std::printf("%-8s %12.1f %12.1f %9ld %9ld\n", "launch", launchBefore,
+              launchAfter,
+              retainedTitle.layouts + retainedInstructions.layouts,
+              ruleLayer.rebuilds);
+  std::printf("%-8s %12.1f %12.1f %9ld %9ld\n", "end", endBefore, endAfter,
+              endLayer[0].layouts + endLayer[1].layouts, endLayer.rebuilds);
+  return 0;
+}
@@ -0,0 +1,185 @@
+#include "Config.hpp"
+#include "Constants.h"
+#include "Replay.hpp"
+#include "World.hpp"
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+static void usage(std::ostream &out) {
+  out << "Usage: headless [simulated seconds] [obstacles] [solver threads]\n"
+      << "                [--record FILE] [--replay FILE]\n"
+      << "                [--config FILE] [--set KEY=VALUE] [--print-config]"
+      << std::endl;
+}
+
+// The whole of text as a number in [low, high]
+static bool parseNumber(const std::string &text, double low, double high,
+                        double &value) {
+  char *end = nullptr;
+  errno = 0;
+  value = std::strtod(text.c_str(), &end);
+  return end != text.c_str() && *end == '\0' && errno == 0 &&
+         std::isfinite(value) && value >= low && value <= high;
+}
+
+static bool parseCount(const std::string &text, int &value) {
+  char *end = nullptr;
+  errno = 0;
+  long parsed = std::strtol(text.c_str(), &end, 10);
+  if (end == text.c_str() || *end != '\0' || errno != 0 || parsed < 0 ||
+      parsed > std::numeric_limits<int>::max())
+    return false;
+  value = static_cast<int>(parsed);
+  return true;
+}
+
+// Render-free driver: steps the World at SIM_DT with a scripted thrust
+// policy, or re-runs a recorded session as fast as possible, and reports
+// simulation throughput. Needs no display or GPU.
+int main(int argc, char *argv[]) {
+  int configExit;
+  if (!config.init(argc, argv, configExit))
+    return configExit;
+  std::string recordPath, replayPath;
+  std::vector<std::string> positional;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool number = arg.size() > 1 && arg[0] == '-' &&
+                  (std::isdigit(static_cast<unsigned char>(arg[1])) ||
+                   arg[1] == '.');
+    if (arg == "--record" && i + 1 < argc) {
+      recordPath = argv[++i];
+    } else if (arg == "--replay" && i + 1 < argc) {
+      replayPath = argv[++i];
+    } else if (arg == "--help" || arg == "-h") {
+      usage(std::cout);
+      return 0;
+    } else if (arg[0] == '-' && !number) {
+      // Unknown option, or --record/--replay without a file
+      std::cerr << "Error: bad argument " << arg << std::endl;
+      usage(std::cerr);
+      return 2;
+    } else {
+      positional.push_back(arg);
+    }
+  }
+
+  double simSeconds = 1000.0;
+  int obstacles = tuning.numObstacles;
+  int threads = tuning.solverThreads;
+  const char *bad = nullptr;
+  if (positional.size() > 3)
+    bad = "too many arguments";
+  else if (positional.size() > 0 &&
+           !parseNumber(positional[0], 0.0, 1e9, simSeconds))
+    bad = "simulated seconds must be a number from 0 to 1e9";
+  else if (positional.size() > 1 && !parseCount(positional[1], obstacles))
+    bad = "obstacles must be a whole number, 0 or more";
+  else if (positional.size() > 2 && !parseCount(positional[2], threads))
+    bad = "solver threads must be a whole number, 0 or more";
+  if (bad) {
+    std::cerr << "Error: " << bad << std::endl;
+    usage(std::cerr);
+    return 2;
+  }
+  const float dt = SIM_DT;
+
+  // A replay brings its own seed and obstacle count
+  Replay replay;
+  std::uint64_t seed = DEFAULT_SEED;
+  if (!replayPath.empty()) {
+    if (!replay.load(replayPath))
+      return 1;
+    if (replay.tickRate != SIM_TICK_RATE) {
+      std::cerr << "Warning: replay was recorded at " << replay.tickRate
+                << " Hz, simulating at " << SIM_TICK_RATE << " Hz"
+                << std::endl;
+    }
+    if (replay.configHash && replay.configHash != Config::hash()) {
+      std::cerr << "Warning: replay was recorded with a different config, "
+                << "it will not play back exactly" << std::endl;
+    }
+    seed = replay.seed;
+    obstacles = static_cast<int>(replay.obstacleCount);
+  }
+
+  World world(obstacles, threads, seed);
+  Replay recording;
+  if (!recordPath.empty()) {
+    recording.tickRate = SIM_TICK_RATE;
+    recording.seed = seed;
+    recording.obstacleCount = static_cast<std::uint32_t>(obstacles);
+    recording.configHash = Config::hash();
+    world.recording = &recording;
+  }
+  world.start();
+
+  long totalTicks = 0;
+  long collisions = 0;
+  int wins = 0;
+  int losses = 0;
+  auto count = [&](const StepEvents &events) {
+    totalTicks++;
+    collisions += events.collisions;
+    if (events.won)
+      wins++;
+    if (events.lost)
+      losses++;
+    profiler.endFrame();
+  };
+
+  auto begin = std::chrono::steady_clock::now();
+  if (!replayPath.empty()) {
+    replay.play([&](bool thrust, bool restart) {
+      if (restart)
+        world.restart();
+      PlayerInput input;
+      input.thrust = thrust;
+      count(world.tick(input));
+    });
+  } else {
+    const long scriptedTicks = std::lround(simSeconds * SIM_TICK_RATE);
+    for (long tick = 0; tick < scriptedTicks; tick++) {
+      // Pulse the thrusters: one second on, one second off
+      PlayerInput input;
+      input.thrust = (tick / SIM_TICK_RATE) % 2 == 0;
+
+      count(world.tick(input));
+      if (world.gameState != GAME_STATE_PLAYING)
+        world.restart();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double wallSeconds = std::chrono::duration<double>(end - begin).count();
+  std::cout << "ticks:            " << totalTicks << "\n"
+            << "simulated (s):    " << totalTicks * dt << "\n"
+            << "wall (s):         " << wallSeconds << "\n";
+  if (totalTicks > 0) {
+    std::cout << "sim s / wall s:   " << (totalTicks * dt) / wallSeconds
+              << "\n"
+              << "us / tick:        " << wallSeconds * 1e6 / totalTicks
+              << "\n";
+  }
+  std::cout << "collision ticks:  " << collisions << "\n"
+            << "wins / losses:    " << wins << " / " << losses << "\n"
+            << "state hash:       " << std::hex << world.stateHash()
+            << std::dec << std::endl;
+
+  if (!recordPath.empty() && recording.save(recordPath)) {
+    std::cout << "recorded " << recording.runs.size() << " runs to "
+              << recordPath << std::endl;
+  }
+
+  // Per-section step timings (make profile builds only)
+  profiler.writeCsv(PROFILER_CSV_PATH);
+  profiler.writeJson(PROFILER_JSON_PATH);
+  return 0;
+}
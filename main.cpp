@@ -1,212 +1,184 @@
-#include "Astronaut.hpp"
+#include "AssetLoader.hpp"
 #include "AudioManager.hpp"
+#include "Config.hpp"
 #include "Constants.h"
-#include "Goal.hpp"
 #include "HUD.hpp"
-#include "Obstacle.hpp"
+#include "IdleMode.hpp"
+#include "Profiler.hpp"
+#include "Replay.hpp"
+#include "SimulationThread.hpp"
+#include "UiLayer.hpp"
+#include "World.hpp"
+#include "WorldRenderer.hpp"
 #include <SFML/Graphics.hpp>
+#include <chrono>
 #include <cmath>
-#include <vector>
-
-void handleCollision(Astronaut &a, Obstacle &o, AudioManager &audioMgr) {
-  sf::Vector2f diff = a.getPosition() - o.getPosition();
-  float distance = std::sqrt(diff.x * diff.x + diff.y * diff.y);
-  float minDistance = a.getRadius() + o.getRadius();
-
-  if (distance < minDistance) {
-    // Static resolution: correction for overlap
-    sf::Vector2f normal = diff / distance;
-    float overlap = minDistance - distance;
-    a.body->move(normal * overlap);
-
-    // Dynamic resolution: inelastic impact with rotational transfer
-    // Collision arm vectors from centers to impact point
-    sf::Vector2f rA = normal * a.getRadius();
-    sf::Vector2f rB = -normal * o.radius;
-
-    // Relative velocity at impact point (including angular components)
-    // v_rel = (vB + wB x rB) - (vA + wA x rA)
-    auto crossZ = [](float w, sf::Vector2f r) {
-      return sf::Vector2f(-w * r.y, w * r.x);
-    };
-    sf::Vector2f vA_total =
-        a.velocity + crossZ(a.angularVelocity * (3.14159f / 180.0f), rA);
-    sf::Vector2f vB_total =
-        o.velocity + crossZ(o.angularVelocity * (3.14159f / 180.0f), rB);
-    sf::Vector2f v_rel = vB_total - vA_total;
-
-    float rel_norm = v_rel.x * normal.x + v_rel.y * normal.y;
-
-    // Only resolve if objects are approaching
-    if (rel_norm < 0) {
-      // Linear impulse magnitude (simplified for circular friction-less feel,
-      // but we add tangential later)
-      float e = COLLISION_BOUNCE_FACTOR;
-      float j = -(1.0f + e) * rel_norm;
-      j /= (1.0f / a.mass + 1.0f / o.mass);
-
-      sf::Vector2f impulse = normal * j;
-
-      // Apply linear impulse
-      a.velocity -= impulse / a.mass;
-      o.velocity += impulse / o.mass;
-
-      // Tangential impulse (Friction/Torque transfer)
-      sf::Vector2f tangent{-normal.y, normal.x};
-      float rel_tan = v_rel.x * tangent.x + v_rel.y * tangent.y;
-      float jt = -rel_tan * COLLISION_FRICTION;
-      jt /= (1.0f / a.mass + 1.0f / o.mass);
-
-      sf::Vector2f frictionImpulse = tangent * jt;
-
-      // Apply torque: torque = r x impulse
-      auto cross2D = [](sf::Vector2f r, sf::Vector2f f) {
-        return r.x * f.y - r.y * f.x;
-      };
-
-      float torqueA = cross2D(rA, -frictionImpulse);
-      float torqueB = cross2D(rB, frictionImpulse);
-
-      // Convert torque to angular velocity change: dw = torque / inertia
-      // Astronaut has explicit inertia, Obstacles have simulated inertia (mr^2)
-      a.angularVelocity += (torqueA / a.inertia) * (180.0f / 3.14159f);
-      o.angularVelocity +=
-          (torqueB / (o.mass * o.radius * o.radius)) * (180.0f / 3.14159f);
-
-      // Momentum transfer from obstacle scale
-      a.velocity += o.velocity * COLLISION_KICK_FACTOR;
+#include <random>
+#include <string>
+
+int main(int argc, char *argv[]) {
+  // --startup-time: print time-to-first-frame and time-to-assets, then exit
+  // --record [FILE]: save the session's seed and inputs for headless replay
+  // --no-sim-thread: update and draw back-to-back on one thread
+  // --no-idle: redraw menus and end screens at the frame limit
+  // --config FILE, --set KEY=VALUE, --print-config: see Config.hpp
+  int configExit;
+  if (!config.init(argc, argv, configExit))
+    return configExit;
+  auto launchTime = std::chrono::steady_clock::now();
+  bool startupTiming = false;
+  bool simThread = true;
+  bool idleMode = true;
+  std::string recordPath;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--startup-time") {
+      startupTiming = true;
+    } else if (arg == "--no-sim-thread") {
+      simThread = false;
+    } else if (arg == "--no-idle") {
+      idleMode = false;
+    } else if (arg == "--record") {
+      recordPath = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i]
+                                                           : REPLAY_DEFAULT_PATH;
     }
-
-    float velocityMagnitude =
-        std::sqrt(a.velocity.x * a.velocity.x + a.velocity.y * a.velocity.y);
-    if (velocityMagnitude > 10) {
-      float oxygen_drain = velocityMagnitude * OXYGEN_DRAIN_COLLISION;
-      a.deplet_oxygen(oxygen_drain);
-    }
-    audioMgr.playCollision();
   }
-}
-
-int main() {
-  sf::RenderWindow window(sf::VideoMode({WINDOW_WIDTH, WINDOW_HEIGHT}),
-                          WINDOW_TITLE);
-  window.setFramerateLimit(FRAMERATE_LIMIT);
+  auto msSinceLaunch = [&launchTime] {
+    return std::chrono::duration<float, std::milli>(
+               std::chrono::steady_clock::now() - launchTime)
+        .count();
+  };
 
-  // Load background texture
-  sf::Texture backgroundTexture;
-  if (!backgroundTexture.loadFromFile(TEX_BACKGROUND)) {
-    std::cerr << "Warning: Could not load " << TEX_BACKGROUND << std::endl;
-  }
-  sf::Sprite background(backgroundTexture);
-  // Scale background to viewport dimensions
-  sf::Vector2u bgSize = backgroundTexture.getSize();
-  background.setScale({static_cast<float>(WINDOW_WIDTH) / bgSize.x,
-                       static_cast<float>(WINDOW_HEIGHT) / bgSize.y});
-
-  // Load asteroid textures (4 variants)
-  sf::Texture asteroidTex1, asteroidTex2, asteroidTex3, asteroidTex4;
-  if (!asteroidTex1.loadFromFile(TEX_ASTEROID_1)) {
-    std::cerr << "Failed to load asteroid texture 1\n";
-  }
-  if (!asteroidTex2.loadFromFile(TEX_ASTEROID_2)) {
-    std::cerr << "Failed to load asteroid texture 2\n";
-  }
-  if (!asteroidTex3.loadFromFile(TEX_ASTEROID_3)) {
-    std::cerr << "Failed to load asteroid texture 3\n";
-  }
-  if (!asteroidTex4.loadFromFile(TEX_ASTEROID_4)) {
-    std::cerr << "Failed to load asteroid texture 4\n";
+  sf::RenderWindow window(
+      sf::VideoMode({static_cast<unsigned>(tuning.windowWidth),
+                     static_cast<unsigned>(tuning.windowHeight)}),
+      WINDOW_TITLE);
+  window.setFramerateLimit(tuning.framerateLimit);
+
+  // Game objects; each session gets a fresh seed, logged for reproduction
+  std::uint64_t seed = std::random_device{}();
+  World world(tuning.numObstacles, tuning.solverThreads, seed);
+  world.collectImpacts = true; // Positional asteroid impact sounds
+  std::cout << "Seed: " << seed << std::endl;
+  Replay recording;
+  if (!recordPath.empty()) {
+    recording.tickRate = SIM_TICK_RATE;
+    recording.seed = seed;
+    recording.obstacleCount = tuning.numObstacles;
+    recording.configHash = Config::hash();
+    world.recording = &recording;
   }
 
-  // Game objects
-  Astronaut player;
+  WorldRenderer renderer;
   HUD hud;
-  Goal wormhole;
   AudioManager audioManager;
   sf::Clock clock;
 
-  audioManager.startBackgroundMusic();
-
-  // Populate world with randomized obstacles
-  std::vector<sf::Texture> asteroidTextures = {asteroidTex1, asteroidTex2,
-                                               asteroidTex3, asteroidTex4};
-  std::vector<Obstacle> asteroids;
-  for (int i = 0; i < NUM_OBSTACLES; i++) {
-    int textureIndex = i % asteroidTextures.size();
-    asteroids.push_back(
-        Obstacle(asteroidTextures[textureIndex],
-                 {static_cast<float>(rand() % WINDOW_WIDTH * 0.8f),
-                  static_cast<float>(rand() % WINDOW_HEIGHT * 0.8f)},
-                 {static_cast<float>(rand() % 100 - 50),
-                  static_cast<float>(rand() % 100 - 50)},
-                 static_cast<float>((rand() % MAX_OBSTACLE_RADIUS) +
-                                    MIN_OBSTACLE_RADIUS)));
-  }
+  // Nothing simulates on the launch and end screens, so they wait for
+  // input instead of redrawing at the frame limit
+  IdlePacer pacer;
+  SceneCache frozenScene;
+  CpuMeter cpuMeter;
+  const sf::Time animationInterval =
+      sf::milliseconds(1000 / IDLE_ANIMATION_FPS);
+
+  // Decode textures and sounds in the background while the launch screen
+  // is already being drawn
+  AssetLoader loader;
+  renderer.requestAssets(loader);
+  audioManager.requestAssets(loader);
+  loader.start();
+  bool assetsReady = false;
+  bool firstFrameShown = false;
 
-  // Game state
-  int gameState = GAME_STATE_START;
+  audioManager.startBackgroundMusic();
 
   // Load font for UI text
   sf::Font font;
-  if (!font.openFromFile(FONT_PATH)) {
-    std::cerr << "Warning: Could not load font from " << FONT_PATH << std::endl;
+  if (!font.openFromFile(config.asset(FONT_PATH))) {
+    std::cerr << "Warning: Could not load font from "
+              << config.asset(FONT_PATH) << std::endl;
   }
 
-  // Create text objects
-  sf::Text gameOverText(font, "", TEXT_SIZE_LARGE);
-  gameOverText.setStyle(sf::Text::Bold);
-
-  sf::Text restartText(font, TEXT_RESTART, TEXT_SIZE_SMALL);
-  restartText.setFillColor(sf::Color::White);
-
-  sf::Text gameTitle(font, TEXT_GAME_TITLE, TEXT_SIZE_LARGE);
-  gameTitle.setFillColor(sf::Color::White);
-  gameTitle.setOutlineThickness(6.0f);
-  gameTitle.setStyle(sf::Text::Bold);
-
-  sf::Text gameStartInstructions(font, TEXT_GAME_START_INSTRUCTIONS,
-                                 TEXT_SIZE_SMALL);
-  gameStartInstructions.setFillColor(sf::Color::White);
-  gameStartInstructions.setOutlineThickness(2.5f);
-  gameStartInstructions.setOutlineColor(sf::Color(0, 0, 0, 200));
-
-  sf::Text rule1(font, TEXT_RULE_1, TEXT_SIZE_SMALL);
-  rule1.setFillColor(sf::Color(255, 255, 255));
-  rule1.setOutlineThickness(1.5f);
-  rule1.setOutlineColor(sf::Color(0, 0, 0, 150));
-
-  sf::Text rule2(font, TEXT_RULE_2, TEXT_SIZE_SMALL);
-  rule2.setFillColor(sf::Color(255, 255, 255));
-  rule2.setOutlineThickness(1.5f);
-  rule2.setOutlineColor(sf::Color(0, 0, 0, 150));
-
-  sf::Text rule3(font, TEXT_RULE_3, TEXT_SIZE_SMALL);
-  rule3.setFillColor(sf::Color(255, 255, 255));
-  rule3.setOutlineThickness(1.5f);
-  rule3.setOutlineColor(sf::Color(0, 0, 0, 150));
-
-  sf::Text rule4(font, TEXT_RULE_4, TEXT_SIZE_SMALL);
-  rule4.setFillColor(sf::Color(255, 255, 255));
-  rule4.setOutlineThickness(1.5f);
-  rule4.setOutlineColor(sf::Color(0, 0, 0, 150));
-
-  // Text alignment helper
-  auto centerText = [](sf::Text &text, float x, float y) {
-    sf::FloatRect bounds = text.getLocalBounds();
-    text.setOrigin({bounds.size.x / 2.0f, bounds.size.y / 2.0f});
-    text.setPosition({x, y});
+  // UI text is laid out once and again only when its content changes;
+  // groups that never change are cached as one image (UiLayer.hpp)
+  const float centerX = tuning.windowWidth / 2.0f;
+  const float height = tuning.windowHeight;
+
+  // Animated every frame, so drawn directly
+  UiText gameTitle(font, TEXT_GAME_TITLE, TEXT_SIZE_LARGE,
+                   {centerX, height * 0.25f});
+  gameTitle.text.setFillColor(sf::Color::White);
+  gameTitle.text.setOutlineThickness(6.0f);
+  gameTitle.text.setStyle(sf::Text::Bold);
+
+  UiText gameStartInstructions(font, TEXT_GAME_START_INSTRUCTIONS,
+                               TEXT_SIZE_SMALL, {centerX, height * 0.45f});
+  gameStartInstructions.text.setFillColor(sf::Color::White);
+  gameStartInstructions.text.setOutlineThickness(2.5f);
+  gameStartInstructions.text.setOutlineColor(sf::Color(0, 0, 0, 200));
+
+  UiText loadingText(font, TEXT_LOADING, TEXT_SIZE_SMALL,
+                     {centerX, height * 0.55f});
+  loadingText.text.setFillColor(sf::Color::White);
+
+  // Static rules panel
+  UiLayer rules;
+  const char *ruleLines[] = {TEXT_RULE_1, TEXT_RULE_2, TEXT_RULE_3,
+                             TEXT_RULE_4};
+  for (int i = 0; i < 4; i++) {
+    sf::Text &rule =
+        rules.add(font, ruleLines[i], TEXT_SIZE_SMALL,
+                  {centerX, height * (0.60f + 0.05f * i)})
+            .text;
+    rule.setFillColor(sf::Color(255, 255, 255));
+    rule.setOutlineThickness(1.5f);
+    rule.setOutlineColor(sf::Color(0, 0, 0, 150));
+  }
+
+  // End screens: message and restart hint
+  auto endScreen = [&](UiLayer &layer, const char *message, sf::Color color) {
+    sf::Text &title = layer.add(font, message, TEXT_SIZE_LARGE,
+                                {centerX, height / 2.0f - 50.0f})
+                          .text;
+    title.setStyle(sf::Text::Bold);
+    title.setFillColor(color);
+    layer.add(font, TEXT_RESTART, TEXT_SIZE_SMALL,
+              {centerX, height / 2.0f + 50.0f})
+        .text.setFillColor(sf::Color::White);
   };
+  UiLayer wonScreen, lostScreen;
+  endScreen(wonScreen, TEXT_MISSION_COMPLETE, sf::Color::Green);
+  endScreen(lostScreen, TEXT_OXYGEN_DEPLETED, sf::Color::Red);
 
-  centerText(gameTitle, WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT * 0.25f);
-  centerText(gameStartInstructions, WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT * 0.45f);
-  centerText(rule1, WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT * 0.60f);
-  centerText(rule2, WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT * 0.65f);
-  centerText(rule3, WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT * 0.70f);
-  centerText(rule4, WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT * 0.75f);
+  sf::RectangleShape loadingBarBack({LOADING_BAR_WIDTH, LOADING_BAR_HEIGHT});
+  loadingBarBack.setFillColor(sf::Color(255, 255, 255, 60));
+  loadingBarBack.setPosition({(tuning.windowWidth - LOADING_BAR_WIDTH) / 2.0f,
+                              tuning.windowHeight * 0.60f});
+  sf::RectangleShape loadingBar = loadingBarBack;
+  loadingBar.setFillColor(sf::Color::White);
 
   // Launch screen state
-  while (gameState == GAME_STATE_START) {
+  while (world.gameState == GAME_STATE_START) {
     float time = clock.getElapsedTime().asSeconds();
+    // Full rate while assets stream in
+    pacer.setIdle(idleMode && assetsReady, animationInterval);
+
+    // Upload whatever finished decoding since the last frame
+    if (!assetsReady) {
+      bool texturesReady = renderer.finishLoading();
+      bool soundsReady = audioManager.finishLoading();
+      assetsReady = texturesReady && soundsReady;
+      if (assetsReady) {
+        // Per-asset load time and texture memory
+        renderer.textures.report(std::cout);
+        if (startupTiming) {
+          std::cout << "Assets ready: " << msSinceLaunch() << " ms"
+                    << std::endl;
+          return 0;
+        }
+      }
+    }
 
     // Dynamic chromatic oscillation for title
     std::uint8_t r =
@@ -215,158 +187,219 @@ int main() {
         static_cast<std::uint8_t>(127 * (1 + std::sin(time * 2.0f + 2.0f)));
     std::uint8_t b =
         static_cast<std::uint8_t>(127 * (1 + std::sin(time * 2.0f + 4.0f)));
-    gameTitle.setFillColor(sf::Color::White);
-    gameTitle.setOutlineColor(sf::Color(r, g, b));
+    gameTitle.text.setOutlineColor(sf::Color(r, g, b));
 
     // Temporal alpha modulation for instructions
     std::uint8_t alpha =
         static_cast<std::uint8_t>(155 + 100 * std::sin(time * 4.0f));
-    gameStartInstructions.setFillColor(sf::Color(255, 255, 255, alpha));
-    gameStartInstructions.setOutlineColor(sf::Color(0, 0, 0, alpha));
+    gameStartInstructions.text.setFillColor(sf::Color(255, 255, 255, alpha));
+    gameStartInstructions.text.setOutlineColor(sf::Color(0, 0, 0, alpha));
 
     window.clear();
-    window.draw(background);
-    window.draw(gameTitle);
-    window.draw(gameStartInstructions);
-    window.draw(rule1);
-    window.draw(rule2);
-    window.draw(rule3);
-    window.draw(rule4);
+    renderer.drawBackground(window);
+    gameTitle.draw(window);
+    if (assetsReady) {
+      gameStartInstructions.draw(window);
+      rules.draw(window);
+    } else {
+      loadingBar.setSize(
+          {LOADING_BAR_WIDTH * loader.progress(), LOADING_BAR_HEIGHT});
+      loadingText.draw(window);
+      window.draw(loadingBarBack);
+      window.draw(loadingBar);
+    }
     window.display();
 
-    // Event handling
-    while (auto eventOpt = window.pollEvent()) {
+    if (!firstFrameShown) {
+      firstFrameShown = true;
+      if (startupTiming)
+        std::cout << "First frame: " << msSinceLaunch() << " ms" << std::endl;
+    }
+
+    // Event handling; idle, this waits for the next animation frame
+    while (auto eventOpt = pacer.nextEvent(window)) {
       if (eventOpt->is<sf::Event::Closed>()) {
         window.close();
-        gameState = -2; // Exit
+        world.gameState = -2; // Exit
       }
 
       // Transition to gameplay state on 'S' key press
       if (eventOpt->is<sf::Event::KeyPressed>()) {
         auto keyEvent = eventOpt->getIf<sf::Event::KeyPressed>();
-        if (keyEvent->code == sf::Keyboard::Key::S) {
-          gameState = GAME_STATE_PLAYING;
-          player.reset_state();
+        if (keyEvent->code == sf::Keyboard::Key::S && assetsReady) {
+          world.start();
           clock.restart(); // Synchronize delta-time
         }
       }
     }
+    pacer.frameDone();
+    if (assetsReady)
+      cpuMeter.frame(true);
+    else
+      cpuMeter.skip(); // Decoding is not idle cost
   }
 
-  while (window.isOpen() && gameState >= 0) {
+  // From here the world is updated on its own thread, one frame ahead of
+  // what is drawn. It also keeps the checkpoints for rewind (B); a replay
+  // can't express a rewind, so that is off while recording.
+  SimulationThread simulation(world, simThread);
+
+  bool frozen = false; // The last frame showed a win or loss
+  while (window.isOpen()) {
+    // Idle on end screens; the profiler overlay still refreshes
+    pacer.setIdle(idleMode && frozen,
+                  hud.showProfiler ? animationInterval : sf::Time::Zero);
     float dt = clock.restart().asSeconds();
+    FrameInput frameInput;
+    frameInput.dt = frozen ? 0.0f : dt; // Time on an end screen is not play
+    frameInput.idle = pacer.isIdle();
 
     // Event handling
-    while (auto eventOpt = window.pollEvent()) {
-      if (eventOpt->is<sf::Event::Closed>()) {
-        window.close();
-      }
+    {
+      PROFILE_SCOPE(PROF_EVENTS);
+      while (auto eventOpt = pacer.nextEvent(window)) {
+        if (eventOpt->is<sf::Event::Closed>()) {
+          window.close();
+        }
 
-      // Transition to reset state on 'R' key press
-      if (eventOpt->is<sf::Event::KeyPressed>()) {
-        auto keyEvent = eventOpt->getIf<sf::Event::KeyPressed>();
-        if (keyEvent->code == sf::Keyboard::Key::R &&
-            gameState != GAME_STATE_PLAYING) {
-          player.reset(); // Re-initialize system state
-          wormhole.reset();
-          gameState = GAME_STATE_PLAYING;
-          audioManager.resetForRestart();
+        if (eventOpt->is<sf::Event::KeyPressed>()) {
+          auto keyEvent = eventOpt->getIf<sf::Event::KeyPressed>();
+          // Transition to reset state on 'R' key press
+          if (keyEvent->code == sf::Keyboard::Key::R) {
+            frameInput.restart = true;
+          }
+          // Rewind to the last checkpoint
+          if (keyEvent->code == sf::Keyboard::Key::B) {
+            frameInput.rewind = true;
+          }
+          // Toggle the performance overlay
+          if (keyEvent->code == sf::Keyboard::Key::F3) {
+            hud.showProfiler = !hud.showProfiler;
+          }
         }
       }
     }
+    frameInput.input.thrust =
+        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space);
+
+    // Hands over this frame's input; threaded, the snapshot returned is
+    // the previous frame's and this one is simulated while it is drawn
+    const RenderSnapshot *frame;
+    {
+      PROFILE_SCOPE(PROF_SIMULATION);
+      frame = &simulation.exchange(frameInput);
+    }
+    // Threaded, the world sections were timed on the simulation thread
+    profiler.merge(frame->profile);
+
+    if (frame->reset)
+      audioManager.resetForRestart();
+
+    if (frame->simulated) {
+      const StepEvents &events = frame->events;
+      {
+        PROFILE_SCOPE(PROF_HUD);
+        hud.update(frame->player, WorldRenderer::screenPosition(
+                                      *frame, frame->player.position));
+      }
 
-    if (gameState == GAME_STATE_PLAYING) {
-      // Update
-      bool is_key_pressed =
-          sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space) &&
-          player.has_thrust();
-
+      PROFILE_SCOPE(PROF_AUDIO);
       // Audio for thrust
-      if (is_key_pressed) {
+      if (events.thrusting) {
         audioManager.playThrust();
       } else {
         audioManager.stopThrust();
       }
 
-      player.update(dt, is_key_pressed);
-      wormhole.update(dt);
-
-      for (auto &ast : asteroids) {
-        ast.update(dt);
-        handleCollision(player, ast, audioManager);
-      }
-
-      hud.update(player);
-      wormhole.checkCollision(player.getPosition(), player.getRadius());
+      // One impact sound per contact, however many frames it lasts, and
+      // the frame's asteroid impacts placed relative to the screen center
+      sf::Vector2f screenCenter(tuning.windowWidth / 2.0f,
+                                tuning.windowHeight / 2.0f);
+      audioManager.updateContact(
+          events.collisions > 0,
+          WorldRenderer::screenPosition(*frame, frame->player.position) -
+              screenCenter);
+      for (const ImpactEvent &impact : frame->impacts)
+        audioManager.playImpact(
+            WorldRenderer::screenPosition(*frame, impact.position) -
+                screenCenter,
+            impact.impulse);
 
       // Oxygen-dependent frequency modulation for breathing audio
-      audioManager.updateBreathing(player.oxygen);
+      audioManager.updateBreathing(frame->player.oxygen);
 
-      // Termination condition evaluation
-      if (wormhole.isReached) {
-        gameState = GAME_STATE_WON;
+      // Termination audio cues
+      if (events.won) {
         audioManager.stopAll();
         audioManager.playVictory();
       }
-      if (player.isDead) {
-        gameState = GAME_STATE_LOST;
+      if (events.lost) {
         audioManager.stopAll();
         audioManager.playDeath();
         audioManager.playGameOver();
       }
     }
 
-    // Draw
-    window.clear(BACKGROUND_COLOR);
-    window.draw(background);
-    wormhole.draw(window);
-    for (auto &ast : asteroids)
-      ast.draw(window);
-    player.draw(window);
-    hud.draw(window);
-
-    // Render termination graphics
-    if (gameState == GAME_STATE_WON) {
-      gameOverText.setString(TEXT_MISSION_COMPLETE);
-      gameOverText.setFillColor(sf::Color::Green);
-
-      // Center the text
-      sf::FloatRect textBounds = gameOverText.getLocalBounds();
-      gameOverText.setOrigin(
-          {textBounds.size.x / 2.0f, textBounds.size.y / 2.0f});
-      gameOverText.setPosition(
-          {WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f - 50.0f});
-
-      sf::FloatRect restartBounds = restartText.getLocalBounds();
-      restartText.setOrigin(
-          {restartBounds.size.x / 2.0f, restartBounds.size.y / 2.0f});
-      restartText.setPosition(
-          {WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f + 50.0f});
-
-      window.draw(gameOverText);
-      window.draw(restartText);
-    } else if (gameState == GAME_STATE_LOST) {
-      gameOverText.setString(TEXT_OXYGEN_DEPLETED);
-      gameOverText.setFillColor(sf::Color::Red);
-
-      // Center the text
-      sf::FloatRect textBounds = gameOverText.getLocalBounds();
-      gameOverText.setOrigin(
-          {textBounds.size.x / 2.0f, textBounds.size.y / 2.0f});
-      gameOverText.setPosition(
-          {WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f - 50.0f});
-
-      sf::FloatRect restartBounds = restartText.getLocalBounds();
-      restartText.setOrigin(
-          {restartBounds.size.x / 2.0f, restartBounds.size.y / 2.0f});
-      restartText.setPosition(
-          {WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f + 50.0f});
-
-      window.draw(gameOverText);
-      window.draw(restartText);
+    // Draw. A frozen world (win or loss) is drawn once into a texture
+    // and reused; only the overlays are drawn live.
+    bool sceneFrozen = frame->gameState != GAME_STATE_PLAYING;
+    bool sceneCached = false;
+    {
+      PROFILE_SCOPE(PROF_DRAW_WORLD);
+      window.clear(BACKGROUND_COLOR);
+      if (!sceneFrozen || !idleMode) {
+        frozenScene.invalidate();
+      } else if (frozenScene.valid() ||
+                 frozenScene.capture(window.getSize(),
+                                     [&](sf::RenderTarget &target) {
+                                       target.clear(BACKGROUND_COLOR);
+                                       renderer.draw(target, *frame);
+                                       hud.draw(target);
+                                     })) {
+        frozenScene.draw(window);
+        sceneCached = true;
+      }
+      if (!sceneCached)
+        renderer.draw(window, *frame);
+    }
+    {
+      PROFILE_SCOPE(PROF_DRAW_HUD);
+      if (!sceneCached)
+        hud.draw(window);
+      hud.drawProfiler(window, font);
     }
 
-    window.display();
+    {
+      PROFILE_SCOPE(PROF_DRAW_TEXT);
+
+      // Render termination graphics
+      if (frame->gameState == GAME_STATE_WON) {
+        wonScreen.draw(window);
+      } else if (frame->gameState == GAME_STATE_LOST) {
+        lostScreen.draw(window);
+      }
+    }
+
+    {
+      PROFILE_SCOPE(PROF_DISPLAY);
+      window.display(); // Includes the frame-limit sleep
+    }
+    profiler.endFrame();
+    pacer.frameDone();
+    cpuMeter.frame(sceneFrozen);
+    // A restart or rewind is answered next frame, so stay awake for it
+    frozen = sceneFrozen && !frameInput.restart && !frameInput.rewind;
+  }
+  simulation.stop(); // The world and recording are ours again
+
+  profiler.writeCsv(PROFILER_CSV_PATH);
+  profiler.writeJson(PROFILER_JSON_PATH);
+  audioManager.report(std::cout);
+  cpuMeter.report(std::cout);
+
+  if (!recordPath.empty() && recording.save(recordPath)) {
+    std::cout << "Replay saved to " << recordPath << " ("
+              << recording.totalTicks() << " ticks)" << std::endl;
   }
   return 0;
 }
\ No newline at end of file
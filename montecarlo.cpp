@@ -0,0 +1,283 @@
+#include "Config.hpp"
+#include "Constants.h"
+#include "Rng.hpp"
+#include "WorkStealingPool.hpp"
+#include "World.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Batch difficulty analysis: runs many independent seeded episodes per
+// parameter set across all cores and reports win rate, time to death,
+// collisions and the mean oxygen curve. Episode e always uses seed
+// baseSeed + e and results are aggregated in episode order, so the output
+// is identical for any thread count.
+
+struct ParamSet {
+  int obstacles = tuning.numObstacles;
+  float oxygenDrain = tuning.oxygenDrainNormal;
+  float thrustDrain = tuning.thrustDrainRate;
+  float collisionDrain = tuning.oxygenDrainCollision;
+};
+
+enum Outcome { OUTCOME_WON, OUTCOME_LOST, OUTCOME_TIMEOUT };
+
+struct EpisodeResult {
+  int outcome = OUTCOME_TIMEOUT;
+  float seconds = 0.0f;
+  int collisions = 0;
+  std::vector<float> oxygen; // Sampled once per simulated second
+};
+
+enum Policy { POLICY_PULSE, POLICY_RANDOM };
+
+static EpisodeResult runEpisode(const ParamSet &params, std::uint64_t seed,
+                                Policy policy) {
+  World world(params.obstacles, 1, seed);
+  world.start();
+  world.player.oxygenDrainRate = params.oxygenDrain;
+  world.player.thrustDrainRate = params.thrustDrain;
+  world.player.collisionDrainFactor = params.collisionDrain;
+
+  // The policy draws from its own stream so it never perturbs the world's
+  Rng policyRng(seed ^ 0x5eed5eed5eed5eedull);
+  bool thrust = false;
+  int holdTicks = 0;
+
+  EpisodeResult result;
+  const long maxTicks = static_cast<long>(MONTE_CARLO_MAX_SECONDS) * SIM_TICK_RATE;
+  long tick = 0;
+  for (; tick < maxTicks && world.gameState == GAME_STATE_PLAYING; tick++) {
+    if (tick % SIM_TICK_RATE == 0)
+      result.oxygen.push_back(world.player.oxygen);
+
+    if (policy == POLICY_PULSE) {
+      // One second on, one second off, as in the headless driver
+      thrust = (tick / SIM_TICK_RATE) % 2 == 0;
+    } else if (holdTicks-- <= 0) {
+      // Hold a random choice for 0.1 to 1 s
+      thrust = policyRng.below(2) == 1;
+      holdTicks = SIM_TICK_RATE / 10 + policyRng.below(SIM_TICK_RATE);
+    }
+
+    PlayerInput input;
+    input.thrust = thrust;
+    StepEvents events = world.tick(input);
+    result.collisions += events.collisions;
+    if (events.won)
+      result.outcome = OUTCOME_WON;
+    if (events.lost)
+      result.outcome = OUTCOME_LOST;
+  }
+  result.seconds = tick * SIM_DT;
+  return result;
+}
+
+// Splits "1,2.5,4" into numbers
+// Comma-separated non-negative numbers; false if any item is not one
+static bool parseList(const char *text, std::vector<float> &values) {
+  values.clear();
+  std::stringstream stream(text);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    char *end = nullptr;
+    float value = std::strtof(item.c_str(), &end);
+    if (item.empty() || *end != '\0' || !std::isfinite(value) || value < 0)
+      return false;
+    values.push_back(value);
+  }
+  return !values.empty();
+}
+
+// A whole non-negative decimal number no larger than max
+static bool parseCount(const char *text, unsigned long long max,
+                       unsigned long long &value) {
+  char *end = nullptr;
+  errno = 0;
+  value = std::strtoull(text, &end, 10);
+  return end != text && *end == '\0' && errno == 0 && text[0] != '-' &&
+         value <= max;
+}
+
+static void usage(std::ostream &out) {
+  out << "Usage: montecarlo [--episodes N] [--threads N] [--seed N]\n"
+      << "                  [--policy pulse|random] [--csv FILE]\n"
+      << "                  [--obstacles a,b,..] [--oxygen-drain a,b,..]\n"
+      << "                  [--thrust-drain a,b,..] [--collision-drain a,b,..]"
+      << "\n"
+      << "                  [--config FILE] [--set KEY=VALUE]\n"
+      << "Every combination of the listed values is one parameter set; values"
+      << "\nnot listed come from the config." << std::endl;
+}
+
+static float percentile(std::vector<float> values, float p) {
+  if (values.empty())
+    return 0.0f;
+  std::sort(values.begin(), values.end());
+  size_t index = static_cast<size_t>(p * (values.size() - 1) + 0.5f);
+  return values[index];
+}
+
+int main(int argc, char *argv[]) {
+  int configExit;
+  if (!config.init(argc, argv, configExit))
+    return configExit;
+  int episodes = 1000;
+  int threads = 0;
+  std::uint64_t baseSeed = DEFAULT_SEED;
+  Policy policy = POLICY_PULSE;
+  std::string csvPath = MONTE_CARLO_CSV_PATH;
+  std::vector<float> obstacles = {static_cast<float>(tuning.numObstacles)};
+  std::vector<float> oxygenDrains = {tuning.oxygenDrainNormal};
+  std::vector<float> thrustDrains = {tuning.thrustDrainRate};
+  std::vector<float> collisionDrains = {tuning.oxygenDrainCollision};
+
+  const unsigned long long intMax = std::numeric_limits<int>::max();
+  for (int i = 1; i < argc; i++) {
+    std::string flag = argv[i];
+    if (flag == "--help" || flag == "-h") {
+      usage(std::cout);
+      return 0;
+    }
+    static const char *const withValue[] = {
+        "--episodes",     "--threads",      "--seed",
+        "--policy",       "--csv",          "--obstacles",
+        "--oxygen-drain", "--thrust-drain", "--collision-drain"};
+    bool known = std::find(std::begin(withValue), std::end(withValue),
+                           flag) != std::end(withValue);
+    if (!known || i + 1 >= argc) {
+      std::cerr << "Error: "
+                << (known ? "missing value for " : "unknown option ") << flag
+                << std::endl;
+      usage(std::cerr);
+      return 2;
+    }
+    const char *value = argv[++i];
+    unsigned long long number = 0;
+    bool valid = true;
+    if (flag == "--episodes") {
+      valid = parseCount(value, intMax, number) && number > 0;
+      episodes = static_cast<int>(number);
+    } else if (flag == "--threads") {
+      valid = parseCount(value, intMax, number);
+      threads = static_cast<int>(number);
+    } else if (flag == "--seed") {
+      valid = parseCount(value, std::numeric_limits<std::uint64_t>::max(),
+                         number);
+      baseSeed = number;
+    } else if (flag == "--policy") {
+      valid = std::strcmp(value, "pulse") == 0 ||
+              std::strcmp(value, "random") == 0;
+      policy = std::strcmp(value, "random") == 0 ? POLICY_RANDOM : POLICY_PULSE;
+    } else if (flag == "--csv") {
+      csvPath = value;
+    } else if (flag == "--obstacles") {
+      valid = parseList(value, obstacles);
+    } else if (flag == "--oxygen-drain") {
+      valid = parseList(value, oxygenDrains);
+    } else if (flag == "--thrust-drain") {
+      valid = parseList(value, thrustDrains);
+    } else if (flag == "--collision-drain") {
+      valid = parseList(value, collisionDrains);
+    }
+    if (!valid) {
+      std::cerr << "Error: bad value for " << flag << ": " << value
+                << std::endl;
+      usage(std::cerr);
+      return 2;
+    }
+  }
+
+  std::vector<ParamSet> sets;
+  for (float n : obstacles)
+    for (float o : oxygenDrains)
+      for (float t : thrustDrains)
+        for (float c : collisionDrains)
+          sets.push_back({static_cast<int>(n), o, t, c});
+
+  // One flat task list over every (set, episode) pair keeps all cores busy
+  // across set boundaries
+  const int total = static_cast<int>(sets.size()) * episodes;
+  std::vector<EpisodeResult> results(total);
+  WorkStealingPool pool(threads);
+
+  auto begin = std::chrono::steady_clock::now();
+  pool.run(total, [&](int task) {
+    int set = task / episodes;
+    int episode = task % episodes;
+    results[task] = runEpisode(sets[set], baseSeed + episode, policy);
+  });
+  double wallSeconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - begin)
+                           .count();
+
+  std::ofstream csv(csvPath);
+  csv << "set,second,mean_oxygen,alive_fraction\n";
+
+  std::cout << std::fixed << std::setprecision(3) << "set obstacles "
+            << "o2_drain thrust_drain coll_drain  win_rate death_p50 "
+            << "death_p90 win_mean_s coll_mean timeouts\n";
+  for (size_t s = 0; s < sets.size(); s++) {
+    const ParamSet &p = sets[s];
+    int wins = 0, timeouts = 0;
+    double collisionSum = 0.0, winSeconds = 0.0;
+    std::vector<float> deathTimes;
+    size_t curveLength = 0;
+    for (int e = 0; e < episodes; e++) {
+      const EpisodeResult &r = results[s * episodes + e];
+      collisionSum += r.collisions;
+      curveLength = std::max(curveLength, r.oxygen.size());
+      if (r.outcome == OUTCOME_WON) {
+        wins++;
+        winSeconds += r.seconds;
+      } else if (r.outcome == OUTCOME_LOST) {
+        deathTimes.push_back(r.seconds);
+      } else {
+        timeouts++;
+      }
+    }
+
+    std::cout << std::setw(3) << s << std::setw(10) << p.obstacles
+              << std::setw(9) << p.oxygenDrain << std::setw(13)
+              << p.thrustDrain << std::setw(11) << p.collisionDrain
+              << std::setw(10) << static_cast<double>(wins) / episodes
+              << std::setw(10) << percentile(deathTimes, 0.5f)
+              << std::setw(10) << percentile(deathTimes, 0.9f)
+              << std::setw(11) << (wins ? winSeconds / wins : 0.0)
+              << std::setw(10) << collisionSum / episodes << std::setw(9)
+              << timeouts << "\n";
+
+    // Finished episodes keep contributing their last value (0 once dead)
+    for (size_t t = 0; t < curveLength; t++) {
+      double sum = 0.0;
+      int alive = 0;
+      for (int e = 0; e < episodes; e++) {
+        const EpisodeResult &r = results[s * episodes + e];
+        if (t < r.oxygen.size()) {
+          sum += r.oxygen[t];
+          alive++;
+        } else if (r.outcome != OUTCOME_LOST && !r.oxygen.empty()) {
+          sum += r.oxygen.back();
+        }
+      }
+      csv << s << "," << t << "," << sum / episodes << ","
+          << static_cast<double>(alive) / episodes << "\n";
+    }
+  }
+
+  std::cout << total << " episodes on " << pool.size() << " threads in "
+            << wallSeconds << " s; oxygen curves in " << csvPath << std::endl;
+  return 0;
+}